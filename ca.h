@@ -97,6 +97,8 @@ typedef struct
 {
     qqbar_struct x;        /* qqbar_t element */
     nf_struct * nf;        /* antic number field for fast arithmetic */
+    slong root_p;          /* x = exp(2 pi i p / q) if x is a root of unity */
+    ulong root_q;          /* q, or 0 if x is not a root of unity */
 }
 ca_ext_qqbar;
 
@@ -115,6 +117,9 @@ typedef struct
     calcium_func_code head;   /* f = F_Pi, F_Exp, ... */
     ulong hash;
     slong depth;
+    slong refcount;           /* Number of cached fields using this generator */
+    ulong gen;                /* Cache generation when last used */
+    struct ca_ctx_struct_tag * owner;   /* Context whose cache holds this */
     union {
         ca_ext_qqbar qqbar;
         ca_ext_func_data func_data;
@@ -133,6 +138,8 @@ typedef const ca_ext_struct * ca_ext_srcptr;
 
 #define CA_EXT_QQBAR(_x) (&((_x)->data.qqbar.x))
 #define CA_EXT_QQBAR_NF(_x) ((_x)->data.qqbar.nf)
+#define CA_EXT_QQBAR_ROOT_P(_x) ((_x)->data.qqbar.root_p)
+#define CA_EXT_QQBAR_ROOT_Q(_x) ((_x)->data.qqbar.root_q)
 
 #define CA_EXT_FUNC_ARGS(x) ((x)->data.func_data.args)
 #define CA_EXT_FUNC_NARGS(x) ((x)->data.func_data.nargs)
@@ -160,6 +167,11 @@ typedef struct
     ca_ext_struct ** ext;        /* Generators                        */
     fmpz_mpoly_vec_struct ideal; /* Algebraic relations for reduction */
     ulong hash;
+    slong refcount;              /* Number of live elements            */
+    ulong gen;                   /* Cache generation when last used    */
+    struct ca_ctx_struct_tag * owner;   /* Context whose cache holds this */
+    slong prec_hint;             /* Precision of the last numerical decision */
+    int ideal_flags;             /* CA_FIELD_IDEAL_* flags             */
 }
 ca_field_struct;
 
@@ -188,6 +200,17 @@ typedef const ca_field_struct * ca_field_srcptr;
 #define CA_MCTX_1(ctx) ((ctx)->mctx[0])
 #define CA_FIELD_MCTX(K, ctx) ((ctx)->mctx[CA_FIELD_LENGTH(K) - 1])
 
+/* The ideal is a reduced Groebner basis */
+#define CA_FIELD_IDEAL_GROEBNER 1
+/* All relation searches ran to completion when the ideal was built */
+#define CA_FIELD_IDEAL_SEARCHED 2
+/* The field is Q(sqrt(p_1), ..., sqrt(p_n)) of degree 2^n and the ideal
+   consists of x_i^2 - p_i */
+#define CA_FIELD_IDEAL_MULTIQUADRATIC 4
+/* Relation searches were cut short by the budget; the ideal is
+   rebuilt when the field is next looked up with budget left */
+#define CA_FIELD_IDEAL_INCOMPLETE 8
+
 typedef struct
 {
     ca_field_struct ** items;
@@ -220,6 +243,16 @@ enum
     CA_OPT_GROEBNER_POLY_BITS_LIMIT,
     CA_OPT_VIETA_LIMIT,
     CA_OPT_TRIG_FORM,
+    CA_OPT_THREAD_SAFE,
+    CA_OPT_CACHE_MEM_LIMIT,
+    CA_OPT_WORK_LIMIT,
+    CA_OPT_TIME_LIMIT,
+    CA_OPT_ACB_CACHE_SIZE,
+    CA_OPT_OP_CACHE_SIZE,
+    CA_OPT_REDUCTION_BATCH_LENGTH,
+    CA_OPT_MERGE_CACHE_SIZE,
+    CA_OPT_PRIMITIVE_DEG_LIMIT,
+    CA_OPT_PRIMITIVE_CACHE_SIZE,
     CA_OPT_NUM_OPTIONS
 };
 
@@ -228,7 +261,94 @@ enum
 #define CA_TRIG_SINE_COSINE  2
 #define CA_TRIG_TANGENT      3
 
+/* Translation table used by ca_transfer, mapping cached objects of
+   a source context to the corresponding objects of the target context */
+typedef struct
+{
+    ulong src_serial;         /* Source context, or 0 if unused */
+    ulong src_gen;            /* Cache generations at which the table is valid */
+    ulong gen;
+    slong length;
+    slong alloc;
+    ulong * keys;
+    ulong * values;
+}
+ca_transfer_table_struct;
+
+#define CA_CTX_TRANSFER_TABLES 4
+
+/* Memoized numerical enclosure of a field element */
+typedef struct
+{
+    ulong hash;               /* ca_hash_repr of x */
+    slong prec;               /* Precision of the enclosure, or 0 if unused */
+    ca_struct x;
+    acb_struct enclosure;
+}
+ca_acb_cache_entry_struct;
+
+/* Memoized result of an arithmetic operation or function */
+typedef struct
+{
+    ulong hash;               /* Combined hash of the operation and operands */
+    slong op;                 /* calcium_func_code, or -1 if unused */
+    ca_struct x;
+    ca_struct y;              /* Second operand of binary operations */
+    ca_struct res;
+}
+ca_op_cache_entry_struct;
+
+/* Memoized common field of two fields */
+typedef struct
+{
+    ca_field_srcptr x;        /* Merged fields, or NULL if unused */
+    ca_field_srcptr y;
+    ca_field_srcptr field;    /* Common field */
+    slong * xgen_map;         /* Images of the generators of x and y in field */
+    slong * ygen_map;
+}
+ca_merge_cache_entry_struct;
+
+/* Memoized primitive element of a field with algebraic generators */
+typedef struct
+{
+    ca_field_srcptr field;    /* Generic field, or NULL if unused */
+    ca_field_srcptr nf;       /* Number field of the primitive element, or NULL */
+    fmpq_poly_struct * images; /* Generators of field as polynomials in the primitive element */
+}
+ca_primitive_cache_entry_struct;
+
+/* Performance counters */
 typedef struct
+{
+    slong ext_cache_hits;
+    slong ext_cache_misses;
+    slong field_cache_hits;
+    slong field_cache_misses;         /* Number of fields built */
+    slong ideal_length;               /* Total length of the ideals built */
+    slong ideal_max_length;           /* Longest ideal built */
+    slong groebner_runs;
+    slong groebner_reductions;        /* S-polynomial reductions */
+    slong lll_calls;                  /* Integer relation searches */
+    slong lll_skipped;                /* Searches already done in a subfield */
+    slong ideal_seeded;               /* Ideals seeded from subfields */
+    slong is_zero_numerical;          /* Numerical zero tests */
+    slong is_zero_prec_steps;         /* Precision steps in numerical zero tests */
+    slong acb_cache_hits;             /* Memoized enclosures reused */
+    slong acb_cache_misses;
+    slong op_cache_hits;              /* Memoized operation results reused */
+    slong op_cache_misses;
+    slong merge_cache_hits;           /* Memoized field merges reused */
+    slong merge_cache_misses;
+    slong primitive_cache_hits;       /* Memoized primitive elements reused */
+    slong primitive_cache_misses;
+    qqbar_stats_struct qqbar;         /* Filled in by ca_ctx_stats_get */
+}
+ca_ctx_stats_struct;
+
+typedef ca_ctx_stats_struct ca_ctx_stats_t[1];
+
+typedef struct ca_ctx_struct_tag
 {
     ca_ext_cache_struct ext_cache;              /* Cached extension objects */
     ca_field_cache_struct field_cache;          /* Cached extension fields  */
@@ -236,7 +356,35 @@ typedef struct
     ca_field_struct * field_qq_i;               /* Quick access to QQ(i)   */
     fmpz_mpoly_ctx_struct ** mctx;              /* Cached contexts for multivariate polys */
     slong mctx_len;
+    fmpz_mpoly_ctx_struct *** mctx_retired;     /* Old mctx arrays, kept for concurrent readers */
+    slong mctx_retired_len;
+    ulong cache_gen;                            /* Current cache generation */
+    slong cache_bytes;                          /* Estimated size of the caches */
+    slong cache_depth;                          /* Nesting depth of field insertion */
+    slong cache_sweep_countdown;                /* Insertions until next automatic sweep */
+    struct ca_ctx_struct_tag * parent;          /* Context this was forked from, or NULL */
+    slong fork_depth;                           /* Number of ancestors */
+    slong fork_count;                           /* Number of live forks of this context */
+    ulong serial;                               /* Unique identifier of this context */
+    ca_transfer_table_struct transfer_table[CA_CTX_TRANSFER_TABLES];
+    slong transfer_table_next;                  /* Next translation table to replace */
+    ca_ctx_stats_struct stats;                  /* Performance counters */
+    slong budget_work;                          /* Work units used since budget start */
+    double budget_start;                        /* Wall clock at budget start (ms) */
+    int budget_exceeded;                        /* Set once the budget runs out */
+    ca_acb_cache_entry_struct * acb_cache;      /* Memoized enclosures of elements */
+    slong acb_cache_size;
+    ca_op_cache_entry_struct * op_cache;        /* Memoized operation results */
+    slong op_cache_size;
+    slong * op_cache_options;                   /* Options the op memo was filled with */
+    ca_merge_cache_entry_struct * merge_cache;  /* Memoized field merges */
+    slong merge_cache_size;
+    ca_primitive_cache_entry_struct * primitive_cache;  /* Memoized primitive elements */
+    slong primitive_cache_size;
     slong * options;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;                      /* Guards caches in thread-safe mode */
+#endif
 }
 ca_ctx_struct;
 
@@ -250,6 +398,8 @@ typedef ca_ctx_struct ca_ctx_t[1];
 /* Context management */
 
 void ca_ctx_init(ca_ctx_t ctx);
+void ca_ctx_init_mpoly_ord(ca_ctx_t ctx, ordering_t ord);
+void ca_ctx_fork(ca_ctx_t ctx, ca_ctx_t parent);
 void ca_ctx_clear(ca_ctx_t ctx);
 void ca_ctx_print(ca_ctx_t ctx);
 
@@ -263,6 +413,136 @@ CA_INLINE void ca_ctx_set_option(ca_ctx_t ctx, slong i, slong value)
     ctx->options[i] = value;
 }
 
+void ca_ctx_lock(ca_ctx_t ctx);
+void ca_ctx_unlock(ca_ctx_t ctx);
+int _ca_ctx_lock_shared(ca_ctx_t ctx);
+void _ca_ctx_unlock_shared(ca_ctx_t ctx, int locked);
+void _ca_ctx_init_lock(ca_ctx_t ctx);
+void _ca_ctx_clear_lock(ca_ctx_t ctx);
+
+void ca_ctx_cache_sweep(ca_ctx_t ctx);
+void _ca_ctx_cache_sweep(ca_ctx_t ctx, int full);
+slong ca_ctx_cache_allocated_bytes(ca_ctx_t ctx);
+
+void _ca_ctx_init_transfer_tables(ca_ctx_t ctx);
+void _ca_ctx_clear_transfer_tables(ca_ctx_t ctx);
+void _ca_ctx_invalidate_transfer_tables(ca_ctx_t ctx);
+ca_transfer_table_struct * _ca_ctx_transfer_table(ca_ctx_t ctx, ca_ctx_t src_ctx);
+ulong _ca_transfer_table_get(const ca_transfer_table_struct * T, const void * key);
+void _ca_transfer_table_set(ca_transfer_table_struct * T, const void * key, ulong value);
+
+void _ca_ctx_clear_acb_cache(ca_ctx_t ctx);
+int _ca_ctx_acb_cache_lookup(acb_t res, const ca_t x, ulong hash, slong prec, ca_ctx_t ctx);
+void _ca_ctx_acb_cache_insert(const ca_t x, ulong hash, const acb_t v, slong prec, ca_ctx_t ctx);
+
+void _ca_ctx_clear_op_cache(ca_ctx_t ctx);
+void _ca_op_cached_unary(ca_t res, const ca_t x, calcium_func_code op,
+    void (*func)(ca_t, const ca_t, ca_ctx_t), ca_ctx_t ctx);
+void _ca_op_cached_binary(ca_t res, const ca_t x, const ca_t y, calcium_func_code op,
+    void (*func)(ca_t, const ca_t, const ca_t, ca_ctx_t), ca_ctx_t ctx);
+
+void ca_ctx_begin_reduction_batch(ca_ctx_t ctx);
+void ca_ctx_end_reduction_batch(ca_ctx_t ctx);
+slong _ca_ctx_reduction_batch_depth(const ca_ctx_t ctx);
+void _ca_ctx_set_reduction_batch_depth(const ca_ctx_t ctx, slong depth);
+
+void _ca_ctx_clear_merge_cache(ca_ctx_t ctx);
+ca_field_srcptr _ca_ctx_merge_cache_lookup(slong * xgen_map, slong * ygen_map,
+    ca_field_srcptr x, ca_field_srcptr y, ca_ctx_t ctx);
+void _ca_ctx_merge_cache_insert(ca_field_srcptr x, ca_field_srcptr y, ca_field_srcptr field,
+    const slong * xgen_map, const slong * ygen_map, ca_ctx_t ctx);
+
+void _ca_ctx_clear_primitive_cache(ca_ctx_t ctx);
+ca_field_srcptr _ca_ctx_get_field_primitive(fmpq_poly_struct * images, ca_field_srcptr field, ca_ctx_t ctx);
+
+void ca_ctx_stats_get(ca_ctx_stats_t stats, ca_ctx_t ctx);
+void ca_ctx_stats_reset(ca_ctx_t ctx);
+void ca_ctx_stats_print(ca_ctx_t ctx);
+void _ca_ctx_stats_zero(ca_ctx_t ctx);
+
+/* Counters may be updated concurrently in thread-safe mode */
+#if FLINT_USES_PTHREAD && defined(__GNUC__)
+#define CA_CTX_STATS_ADD(ctx, counter, n) \
+    do { if ((ctx)->options[CA_OPT_THREAD_SAFE]) \
+        __sync_add_and_fetch(&(ctx)->stats.counter, (n)); \
+    else (ctx)->stats.counter += (n); } while (0)
+#else
+#define CA_CTX_STATS_ADD(ctx, counter, n) \
+    do { (ctx)->stats.counter += (n); } while (0)
+#endif
+
+void ca_ctx_budget_start(ca_ctx_t ctx);
+int ca_ctx_budget_exceeded(ca_ctx_t ctx);
+void _ca_ctx_budget_charge(ca_ctx_t ctx, slong units);
+
+void ca_ctx_cache_write(calcium_stream_t out, ca_ctx_t ctx);
+int ca_ctx_cache_read(ca_ctx_t ctx, const char * data, slong len);
+int ca_ctx_cache_fread(ca_ctx_t ctx, FILE * fp);
+ulong _ca_ctx_cache_checksum(const char * s, slong len);
+
+/* Whether a cached field or extension number belongs to ctx itself rather
+   than to an ancestor that ctx was forked from (or to a sibling fork) */
+#define CA_CTX_OWNS(obj, ctx) ((obj)->owner == (ctx))
+
+/* Reference counting for fields; QQ is never evicted, so we skip it */
+
+CA_INLINE void
+_ca_field_incref(ca_field_srcptr K, ca_ctx_t ctx)
+{
+    ca_field_ptr L = (ca_field_ptr) K;
+
+    /* fields owned by a parent context are not counted; the parent
+       never evicts anything while it has live forks */
+    if (L == ctx->field_qq || !CA_CTX_OWNS(L, ctx))
+        return;
+
+#if FLINT_USES_PTHREAD
+    if (ctx->options[CA_OPT_THREAD_SAFE])
+    {
+#if defined(__GNUC__)
+        __sync_add_and_fetch(&L->refcount, 1);
+#else
+        ca_ctx_lock(ctx);
+        L->refcount++;
+        ca_ctx_unlock(ctx);
+#endif
+        return;
+    }
+#endif
+
+    L->refcount++;
+}
+
+CA_INLINE void
+_ca_field_decref(ca_field_srcptr K, ca_ctx_t ctx)
+{
+    ca_field_ptr L = (ca_field_ptr) K;
+    slong c;
+
+    if (L == ctx->field_qq || !CA_CTX_OWNS(L, ctx))
+        return;
+
+#if FLINT_USES_PTHREAD
+    if (ctx->options[CA_OPT_THREAD_SAFE])
+    {
+#if defined(__GNUC__)
+        c = __sync_sub_and_fetch(&L->refcount, 1);
+#else
+        ca_ctx_lock(ctx);
+        c = --L->refcount;
+        ca_ctx_unlock(ctx);
+#endif
+    }
+    else
+#endif
+        c = --L->refcount;
+
+    /* protect the field from being evicted by the next automatic sweep
+       in case the caller still holds a pointer to it */
+    if (c == 0)
+        L->gen = ctx->cache_gen;
+}
+
 ca_field_ptr _ca_ctx_get_field_const(ca_ctx_t ctx, calcium_func_code func);
 ca_field_ptr _ca_ctx_get_field_fx(ca_ctx_t ctx, calcium_func_code func, const ca_t x);
 ca_field_ptr _ca_ctx_get_field_fxy(ca_ctx_t ctx, calcium_func_code func, const ca_t x, const ca_t y);
@@ -272,6 +552,7 @@ ca_field_ptr _ca_ctx_get_field_fxy(ca_ctx_t ctx, calcium_func_code func, const c
 void ca_init(ca_t x, ca_ctx_t ctx);
 void ca_clear(ca_t x, ca_ctx_t ctx);
 void ca_swap(ca_t x, ca_t y, ca_ctx_t ctx);
+slong ca_allocated_bytes(const ca_t x, ca_ctx_t ctx);
 void _ca_make_field_element(ca_t x, ca_field_srcptr field, ca_ctx_t ctx);
 
 CA_INLINE void
@@ -299,6 +580,7 @@ _ca_function_fxy(ca_t res, calcium_func_code func, const ca_t x, const ca_t y, c
 
 void ca_set(ca_t res, const ca_t x, ca_ctx_t ctx);
 void ca_transfer(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx);
+void _ca_transfer(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx, ca_transfer_table_struct * T);
 
 void ca_zero(ca_t x, ca_ctx_t ctx);
 void ca_one(ca_t x, ca_ctx_t ctx);
@@ -351,6 +633,7 @@ int ca_set_fexpr(ca_t res, const fexpr_t expr, ca_ctx_t ctx);
 void ca_print(const ca_t x, ca_ctx_t ctx);
 void ca_fprint(FILE * fp, const ca_t x, ca_ctx_t ctx);
 void ca_printn(const ca_t x, slong n, ca_ctx_t ctx);
+void _ca_write(calcium_stream_t out, const ca_t x, ulong flags, ca_ctx_t ctx);
 char * ca_get_str(const ca_t x, ca_ctx_t ctx);
 
 /* Random generation */
@@ -444,6 +727,8 @@ ulong ca_hash_repr(const ca_t x, ca_ctx_t ctx);
 /* Field structure operations */
 
 void ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx);
+ca_field_srcptr _ca_merge_fields_vec(ca_ptr res, ca_srcptr x, slong len, ca_ctx_t ctx);
+void ca_merge_fields_vec(ca_ptr res, ca_srcptr x, slong len, ca_ctx_t ctx);
 void ca_condense_field(ca_t res, ca_ctx_t ctx);
 ca_ext_ptr ca_is_gen_as_ext(const ca_t x, ca_ctx_t ctx);
 
@@ -453,6 +738,9 @@ ca_ext_ptr ca_is_gen_as_ext(const ca_t x, ca_ctx_t ctx);
 void _ca_mpoly_q_reduce_ideal(fmpz_mpoly_q_t res, ca_field_srcptr field, ca_ctx_t ctx);
 void _ca_mpoly_q_simplify_fraction_ideal(fmpz_mpoly_q_t res, ca_field_srcptr field, ca_ctx_t ctx);
 
+int _ca_reduction_deferred(const ca_t x, ca_ctx_t ctx);
+void ca_reduce(ca_t x, ca_ctx_t ctx);
+
 
 void ca_neg(ca_t res, const ca_t x, ca_ctx_t ctx);
 
@@ -493,6 +781,8 @@ void ca_div(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx);
 
 void ca_dot(ca_t res, const ca_t initial, int subtract,
     ca_srcptr x, slong xstep, ca_srcptr y, slong ystep, slong len, ca_ctx_t ctx);
+void ca_addmul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx);
+void ca_submul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx);
 
 void ca_fmpz_poly_evaluate(ca_t res, const fmpz_poly_t poly, const ca_t x, ca_ctx_t ctx);
 void ca_fmpq_poly_evaluate(ca_t res, const fmpq_poly_t poly, const ca_t x, ca_ctx_t ctx);
@@ -593,6 +883,9 @@ void ca_gamma(ca_t res, const ca_t x, ca_ctx_t ctx);
 /* Numerical evaluation */
 
 void ca_get_acb_raw(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx);
+void _ca_get_acb_raw_gens(acb_t res, const ca_t x, acb_srcptr gens, slong prec, ca_ctx_t ctx);
+slong _ca_start_prec(const ca_t x, ca_ctx_t ctx);
+void _ca_record_prec(const ca_t x, slong prec, ca_ctx_t ctx);
 void ca_get_acb(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx);
 void ca_get_acb_accurate_parts(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx);
 
@@ -11,11 +11,108 @@
 
 #include "ca.h"
 
+/* Replace x_i^e by p_i^floor(e/2) x_i^(e mod 2). */
+static void
+_fmpz_mpoly_reduce_multiquadratic(fmpz_mpoly_t res, const fmpz_mpoly_t f, const fmpz * p, fmpz_mpoly_ctx_t mctx)
+{
+    slong i, j, n;
+    ulong * exp;
+    fmpz_mpoly_t t;
+    fmpz_t c, u;
+
+    n = mctx->minfo->nvars;
+    exp = flint_malloc(sizeof(ulong) * n);
+
+    fmpz_mpoly_init(t, mctx);
+    fmpz_init(c);
+    fmpz_init(u);
+
+    for (i = 0; i < f->length; i++)
+    {
+        fmpz_mpoly_get_term_exp_ui(exp, f, i, mctx);
+        fmpz_set(c, f->coeffs + i);
+
+        for (j = 0; j < n; j++)
+        {
+            if (exp[j] >= 2)
+            {
+                fmpz_pow_ui(u, p + j, exp[j] / 2);
+                fmpz_mul(c, c, u);
+                exp[j] %= 2;
+            }
+        }
+
+        fmpz_mpoly_push_term_fmpz_ui(t, c, exp, mctx);
+    }
+
+    fmpz_mpoly_sort_terms(t, mctx);
+    fmpz_mpoly_combine_like_terms(t, mctx);
+    fmpz_mpoly_swap(res, t, mctx);
+
+    fmpz_mpoly_clear(t, mctx);
+    fmpz_clear(c);
+    fmpz_clear(u);
+    flint_free(exp);
+}
+
+/* In Q(sqrt(p_1), ..., sqrt(p_n)), both parts of the fraction can be
+   reduced termwise, and multiplying through by the conjugates
+   x_i -> -x_i of the denominator makes the denominator an integer. The
+   result is a canonical representation. */
+static void
+_ca_mpoly_q_reduce_multiquadratic(fmpz_mpoly_q_t res, ca_field_srcptr field, ca_ctx_t ctx)
+{
+    slong i, j, n;
+    fmpz * p;
+    fmpz_mpoly_t c;
+    fmpz_mpoly_struct * num, * den;
+
+    n = CA_FIELD_LENGTH(field);
+    num = fmpz_mpoly_q_numref(res);
+    den = fmpz_mpoly_q_denref(res);
+
+    p = _fmpz_vec_init(n);
+    for (i = 0; i < n; i++)
+        fmpz_neg(p + i, QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(field, i))));
+
+    _fmpz_mpoly_reduce_multiquadratic(num, num, p, CA_FIELD_MCTX(field, ctx));
+    _fmpz_mpoly_reduce_multiquadratic(den, den, p, CA_FIELD_MCTX(field, ctx));
+
+    fmpz_mpoly_init(c, CA_FIELD_MCTX(field, ctx));
+
+    for (i = 0; i < n; i++)
+    {
+        if (fmpz_mpoly_degree_si(den, i, CA_FIELD_MCTX(field, ctx)) <= 0)
+            continue;
+
+        fmpz_mpoly_set(c, den, CA_FIELD_MCTX(field, ctx));
+        for (j = 0; j < c->length; j++)
+            if (fmpz_mpoly_get_term_var_exp_ui(c, j, i, CA_FIELD_MCTX(field, ctx)) % 2 == 1)
+                fmpz_neg(c->coeffs + j, c->coeffs + j);
+
+        fmpz_mpoly_mul(num, num, c, CA_FIELD_MCTX(field, ctx));
+        fmpz_mpoly_mul(den, den, c, CA_FIELD_MCTX(field, ctx));
+        _fmpz_mpoly_reduce_multiquadratic(num, num, p, CA_FIELD_MCTX(field, ctx));
+        _fmpz_mpoly_reduce_multiquadratic(den, den, p, CA_FIELD_MCTX(field, ctx));
+    }
+
+    fmpz_mpoly_q_canonicalise(res, CA_FIELD_MCTX(field, ctx));
+
+    fmpz_mpoly_clear(c, CA_FIELD_MCTX(field, ctx));
+    _fmpz_vec_clear(p, n);
+}
+
 void
 _ca_mpoly_q_reduce_ideal(fmpz_mpoly_q_t res, ca_field_srcptr field, ca_ctx_t ctx)
 {
     slong i, n;
 
+    if (field->ideal_flags & CA_FIELD_IDEAL_MULTIQUADRATIC)
+    {
+        _ca_mpoly_q_reduce_multiquadratic(res, field, ctx);
+        return;
+    }
+
     n = CA_FIELD_IDEAL_LENGTH(field);
 
     /* todo: optimizations */
@@ -227,8 +324,8 @@ ca_add_si(ca_t res, const ca_t x, slong y, ca_ctx_t ctx)
     fmpz_clear(t);
 }
 
-void
-ca_add(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+static void
+_ca_add_uncached(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     ca_field_srcptr xfield, yfield, zfield;
 
@@ -340,6 +437,11 @@ ca_add(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
         else
         {
             fmpz_mpoly_q_add(CA_MPOLY_Q(res), CA_MPOLY_Q(x), CA_MPOLY_Q(y), CA_FIELD_MCTX(zfield, ctx));
+
+            /* inside a reduction batch; see ca_reduce */
+            if (_ca_reduction_deferred(res, ctx))
+                return;
+
             _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), zfield, ctx);
             _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), zfield, ctx);
         }
@@ -365,6 +467,12 @@ ca_add(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
     }
 }
 
+void
+ca_add(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    _ca_op_cached_binary(res, x, y, CA_Add, _ca_add_uncached, ctx);
+}
+
 void
 ca_sub_fmpq(ca_t res, const ca_t x, const fmpq_t y, ca_ctx_t ctx)
 {
@@ -467,6 +575,11 @@ ca_sub(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
         else
         {
             fmpz_mpoly_q_sub(CA_MPOLY_Q(res), CA_MPOLY_Q(x), CA_MPOLY_Q(y), CA_FIELD_MCTX(zfield, ctx));
+
+            /* inside a reduction batch; see ca_reduce */
+            if (_ca_reduction_deferred(res, ctx))
+                return;
+
             _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), zfield, ctx);
             _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), zfield, ctx);
         }
@@ -0,0 +1,59 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+static slong
+_fmpz_vec_mpz_bytes(const fmpz * vec, slong len)
+{
+    slong i, size = 0;
+
+    for (i = 0; i < len; i++)
+        if (COEFF_IS_MPZ(vec[i]))
+            size += sizeof(__mpz_struct) + COEFF_TO_PTR(vec[i])->_mp_alloc * sizeof(mp_limb_t);
+
+    return size;
+}
+
+slong
+ca_allocated_bytes(const ca_t x, ca_ctx_t ctx)
+{
+    ca_field_srcptr field;
+
+    field = (ca_field_srcptr) (x->field & ~CA_SPECIAL);
+
+    if (field == NULL)
+        return 0;
+
+    if (field == ctx->field_qq)
+        return _fmpz_vec_mpz_bytes(CA_FMPQ_NUMREF(x), 1) +
+               _fmpz_vec_mpz_bytes(CA_FMPQ_DENREF(x), 1);
+
+    if (CA_FIELD_IS_NF(field))
+    {
+        const nf_elem_struct * a = CA_NF_ELEM(x);
+
+        if (CA_FIELD_NF(field)->flag & NF_LINEAR)
+            return _fmpz_vec_mpz_bytes(LNF_ELEM_NUMREF(a), 1) +
+                   _fmpz_vec_mpz_bytes(LNF_ELEM_DENREF(a), 1);
+        else if (CA_FIELD_NF(field)->flag & NF_QUADRATIC)
+            return _fmpz_vec_mpz_bytes(QNF_ELEM_NUMREF(a), 3) +
+                   _fmpz_vec_mpz_bytes(QNF_ELEM_DENREF(a), 1);
+        else
+            return NF_ELEM(a)->alloc * sizeof(fmpz) +
+                   _fmpz_vec_mpz_bytes(NF_ELEM_NUMREF(a), NF_ELEM(a)->length) +
+                   _fmpz_vec_mpz_bytes(NF_ELEM_DENREF(a), 1);
+    }
+
+    return sizeof(fmpz_mpoly_q_struct) +
+        fmpz_mpoly_allocated_bytes(fmpz_mpoly_q_numref(CA_MPOLY_Q(x)), CA_FIELD_MCTX(field, ctx)) +
+        fmpz_mpoly_allocated_bytes(fmpz_mpoly_q_denref(CA_MPOLY_Q(x)), CA_FIELD_MCTX(field, ctx));
+}
@@ -19,7 +19,7 @@ _ca_cmp(const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     acb_t v, w;
     truth_t x_real, y_real;
-    slong prec, prec_limit;
+    slong prec, prec_limit, start_prec;
     int result;
 
     if (CA_IS_QQ(x, ctx) && CA_IS_QQ(y, ctx))
@@ -113,7 +113,9 @@ _ca_cmp(const ca_t x, const ca_t y, ca_ctx_t ctx)
     prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
     prec_limit = FLINT_MAX(prec_limit, 64);
 
-    for (prec = 64; (prec <= prec_limit) && (result == CMP_UNKNOWN); prec *= 2)
+    start_prec = FLINT_MAX(_ca_start_prec(x, ctx), _ca_start_prec(y, ctx));
+
+    for (prec = start_prec; (prec <= prec_limit) && (result == CMP_UNKNOWN); prec *= 2)
     {
         ca_get_acb_raw(v, x, prec, ctx);
         ca_get_acb_raw(w, y, prec, ctx);
@@ -136,9 +138,9 @@ _ca_cmp(const ca_t x, const ca_t y, ca_ctx_t ctx)
         }
 
         /* Force a verification that we have comparable numbers. */
-        if (x_real == T_UNKNOWN && prec == 64)
+        if (x_real == T_UNKNOWN && prec == start_prec)
             x_real = ca_check_is_real(x, ctx);
-        if (y_real == T_UNKNOWN && prec == 64)
+        if (y_real == T_UNKNOWN && prec == start_prec)
             y_real = ca_check_is_real(y, ctx);
 
         if (x_real == T_FALSE || y_real == T_FALSE)
@@ -152,19 +154,22 @@ _ca_cmp(const ca_t x, const ca_t y, ca_ctx_t ctx)
         {
             if (arb_gt(acb_realref(v), acb_realref(w)))
             {
+                _ca_record_prec(x, prec, ctx);
+                _ca_record_prec(y, prec, ctx);
                 result = 1;
                 break;
             }
             else if (arb_lt(acb_realref(v), acb_realref(w)))
             {
+                _ca_record_prec(x, prec, ctx);
+                _ca_record_prec(y, prec, ctx);
                 result = -1;
                 break;
             }
         }
 
         /* try qqbar computation */
-        /* todo: precision to do this should depend on complexity of the polynomials, degree of the elements... */
-        if (prec == 64)
+        if (prec == start_prec)
         {
             if (ca_can_evaluate_qqbar(x, ctx) && ca_can_evaluate_qqbar(y, ctx))
             {
@@ -40,7 +40,7 @@ ca_check_is_negative_real(const ca_t x, ca_ctx_t ctx)
     {
         acb_t t;
         truth_t res, is_real;
-        slong prec, prec_limit;
+        slong prec, prec_limit, start_prec;
 
         res = T_UNKNOWN;
 
@@ -51,7 +51,9 @@ ca_check_is_negative_real(const ca_t x, ca_ctx_t ctx)
 
         is_real = T_UNKNOWN;
 
-        for (prec = 64; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
+        start_prec = _ca_start_prec(x, ctx);
+
+        for (prec = start_prec; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
         {
             ca_get_acb_raw(t, x, prec, ctx);
 
@@ -65,17 +67,19 @@ ca_check_is_negative_real(const ca_t x, ca_ctx_t ctx)
 
             if ((is_real == T_TRUE) && arb_is_negative(acb_realref(t)))
             {
+                _ca_record_prec(x, prec, ctx);
                 res = T_TRUE;
                 break;
             }
 
             if ((is_real == T_FALSE) || arb_is_nonnegative(acb_realref(t)))
             {
+                _ca_record_prec(x, prec, ctx);
                 res = T_FALSE;
                 break;
             }
 
-            if (prec == 64 && is_real == T_UNKNOWN)
+            if (prec == start_prec && is_real == T_UNKNOWN)
             {
                 ca_t t;
                 ca_init(t, ctx);
@@ -90,8 +94,7 @@ ca_check_is_negative_real(const ca_t x, ca_ctx_t ctx)
             }
 
             /* try qqbar computation */
-            /* todo: precision to do this should depend on complexity of the polynomials, degree of the elements... */
-            if (prec == 64)
+            if (prec == start_prec)
             {
                 qqbar_t a;
                 qqbar_init(a);
@@ -34,7 +34,7 @@ ca_check_is_rational(const ca_t x, ca_ctx_t ctx)
     {
         acb_t t;
         truth_t res;
-        slong prec, prec_limit;
+        slong prec, prec_limit, start_prec;
 
         res = T_UNKNOWN;
 
@@ -43,19 +43,21 @@ ca_check_is_rational(const ca_t x, ca_ctx_t ctx)
         prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
         prec_limit = FLINT_MAX(prec_limit, 64);
 
-        for (prec = 64; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
+        start_prec = _ca_start_prec(x, ctx);
+
+        for (prec = start_prec; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
         {
             ca_get_acb_raw(t, x, prec, ctx);
 
             if (!arb_contains_zero(acb_imagref(t)))
             {
+                _ca_record_prec(x, prec, ctx);
                 res = T_FALSE;
                 break;
             }
 
             /* try qqbar computation */
-            /* todo: precision to do this should depend on complexity of the polynomials, degree of the elements... */
-            if (prec == 64)
+            if (prec == start_prec)
             {
                 qqbar_t a;
                 qqbar_init(a);
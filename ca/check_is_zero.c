@@ -69,6 +69,26 @@ ca_is_zero_check_fast(const ca_t x, ca_ctx_t ctx)
             return T_FALSE;
     }
 
+    /* The monomials of degree < 2 in each variable form a basis of
+       Q(sqrt(p_1), ..., sqrt(p_n)). */
+    if (CA_FIELD(x, ctx)->ideal_flags & CA_FIELD_IDEAL_MULTIQUADRATIC)
+    {
+        const fmpz_mpoly_struct * num;
+        slong i, len;
+
+        num = fmpz_mpoly_q_numref(CA_MPOLY_Q(x));
+        len = CA_FIELD_LENGTH(CA_FIELD(x, ctx));
+
+        if (fmpz_mpoly_is_zero(num, CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx)))
+            return T_TRUE;
+
+        for (i = 0; i < len; i++)
+            if (fmpz_mpoly_degree_si(num, i, CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx)) >= 2)
+                return T_UNKNOWN;
+
+        return T_FALSE;
+    }
+
     return T_UNKNOWN;
 }
 
@@ -83,7 +103,7 @@ ca_check_is_zero_no_factoring(const ca_t x, ca_ctx_t ctx)
 {
     acb_t v;
     truth_t res;
-    slong prec, prec_limit;
+    slong prec, prec_limit, start_prec;
 
     res = ca_is_zero_check_fast(x, ctx);
 
@@ -109,19 +129,29 @@ ca_check_is_zero_no_factoring(const ca_t x, ca_ctx_t ctx)
     prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
     prec_limit = FLINT_MAX(prec_limit, 64);
 
-    for (prec = 64; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
+    CA_CTX_STATS_ADD(ctx, is_zero_numerical, 1);
+
+    start_prec = _ca_start_prec(x, ctx);
+
+    for (prec = start_prec; (prec <= prec_limit) && (res == T_UNKNOWN); prec *= 2)
     {
+        if (ca_ctx_budget_exceeded(ctx))
+            break;
+
+        CA_CTX_STATS_ADD(ctx, is_zero_prec_steps, 1);
+        _ca_ctx_budget_charge(ctx, 1);
+
         ca_get_acb_raw(v, x, prec, ctx);
 
         if (!acb_contains_zero(v))
         {
+            _ca_record_prec(x, prec, ctx);
             res = T_FALSE;
             break;
         }
 
         /* try qqbar computation */
-        /* todo: precision to do this should depend on complexity of the polynomials, degree of the elements... */
-        if (prec == 64)
+        if (prec == start_prec)
         {
             res = _ca_check_is_zero_qqbar(x, ctx);
         }
@@ -129,7 +159,7 @@ ca_check_is_zero_no_factoring(const ca_t x, ca_ctx_t ctx)
 
     acb_clear(v);
 
-    if (res == T_UNKNOWN)
+    if (res == T_UNKNOWN && !ca_ctx_budget_exceeded(ctx))
     {
         ca_t tmp;
         ca_init(tmp, ctx);
@@ -155,9 +185,28 @@ ca_check_is_zero(const ca_t x, ca_ctx_t ctx)
 {
     truth_t res;
 
+    /* the input may be unreduced inside a reduction batch */
+    if (_ca_ctx_reduction_batch_depth(ctx) != 0 && !CA_IS_SPECIAL(x) && CA_FIELD_IS_GENERIC(CA_FIELD(x, ctx)))
+    {
+        ca_t t;
+        slong depth;
+
+        ca_init(t, ctx);
+        ca_set(t, x, ctx);
+        ca_reduce(t, ctx);
+
+        depth = _ca_ctx_reduction_batch_depth(ctx);
+        _ca_ctx_set_reduction_batch_depth(ctx, 0);
+        res = ca_check_is_zero(t, ctx);
+        _ca_ctx_set_reduction_batch_depth(ctx, depth);
+
+        ca_clear(t, ctx);
+        return res;
+    }
+
     res = ca_check_is_zero_no_factoring(x, ctx);
 
-    if (res == T_UNKNOWN && !CA_IS_SPECIAL(x))
+    if (res == T_UNKNOWN && !CA_IS_SPECIAL(x) && !ca_ctx_budget_exceeded(ctx))
     {
         ca_factor_t fac;
         ca_t t;
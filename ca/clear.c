@@ -36,6 +36,8 @@ ca_clear_unchecked(ca_t x, ca_ctx_t ctx)
             fmpz_mpoly_q_clear(CA_MPOLY_Q(x), CA_FIELD_MCTX(field, ctx));
             flint_free(x->elem.mpoly_q);
         }
+
+        _ca_field_decref(field, ctx);
     }
 }
 
@@ -80,6 +82,8 @@ ca_clear(ca_t x, ca_ctx_t ctx)
             fmpz_mpoly_q_clear(CA_MPOLY_Q(x), CA_FIELD_MCTX(field, ctx));
             flint_free(x->elem.mpoly_q);
         }
+
+        _ca_field_decref(field, ctx);
     }
 }
 
@@ -10,6 +10,7 @@
 */
 
 #include "ca.h"
+#include "ca_field.h"
 
 ca_field_ptr ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x, ca_ctx_t ctx);
 
@@ -91,8 +92,6 @@ ca_condense_field(ca_t res, ca_ctx_t ctx)
     }
     else
     {
-        /* todo: demote to smaller field (in particular, single generator) */
-
         if (fmpz_mpoly_q_is_fmpq(CA_MPOLY_Q(res), CA_FIELD_MCTX(field, ctx)))
         {
             fmpq_t t;
@@ -108,7 +107,7 @@ ca_condense_field(ca_t res, ca_ctx_t ctx)
         }
         else
         {
-            slong i, nvars, count;
+            slong i, j, nvars, count, first;
             int * used;
             TMP_INIT;
 
@@ -123,7 +122,11 @@ ca_condense_field(ca_t res, ca_ctx_t ctx)
             for (i = 0; i < nvars; i++)
                 count += used[i];
 
-            if (count == 1)
+            first = 0;
+            while (!used[first])
+                first++;
+
+            if (count == 1 && CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(field, first)))
             {
                 for (i = 0; i < nvars; i++)
                 {
@@ -137,12 +140,18 @@ ca_condense_field(ca_t res, ca_ctx_t ctx)
                             const fmpz_mpoly_ctx_struct * mctx;
                             fmpz_mpoly_q_struct * F = CA_MPOLY_Q(res);
 
-                            fmpq_poly_init(P);
-
                             mctx = CA_FIELD_MCTX(field, ctx);
                             new_field = ca_field_cache_lookup_qqbar(CA_CTX_FIELD_CACHE(ctx),
                                 CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(field, i)), ctx);
 
+                            /* the number field may have been evicted
+                               from the cache while the generator lives on */
+                            if (new_field == NULL)
+                                new_field = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx),
+                                    CA_FIELD_EXT(field) + i, 1, ctx);
+
+                            fmpq_poly_init(P);
+
                             if (fmpz_mpoly_is_fmpz(fmpz_mpoly_q_denref(F), mctx))
                             {
                                 _fmpz_mpoly_get_fmpq_poly_var_destructive(P, fmpz_mpoly_q_numref(F), i, mctx);
@@ -190,6 +199,59 @@ ca_condense_field(ca_t res, ca_ctx_t ctx)
                     }
                 }
             }
+            else if (count < nvars)
+            {
+                /* demote to the subfield generated by the used generators */
+                ca_field_ptr new_field;
+                ca_ext_struct ** ext;
+                slong * gen_map;
+                fmpz_mpoly_ctx_struct * mctx;
+                fmpz_mpoly_ctx_struct * new_mctx;
+                fmpz_mpoly_q_t F;
+
+                ext = TMP_ALLOC(sizeof(ca_ext_struct *) * count);
+                gen_map = TMP_ALLOC(sizeof(slong) * nvars);
+
+                /* unused variables do not occur, so their image is arbitrary */
+                for (i = j = 0; i < nvars; i++)
+                {
+                    if (used[i])
+                    {
+                        ext[j] = CA_FIELD_EXT_ELEM(field, i);
+                        gen_map[i] = j;
+                        j++;
+                    }
+                    else
+                    {
+                        gen_map[i] = 0;
+                    }
+                }
+
+                /* the generators of a field are sorted, so any subsequence
+                   is in canonical order */
+                new_field = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), ext, count, ctx);
+
+                mctx = CA_FIELD_MCTX(field, ctx);
+                new_mctx = CA_FIELD_MCTX(new_field, ctx);
+
+                /* the variable order is preserved, so the fraction
+                   stays in canonical form */
+                fmpz_mpoly_q_init(F, new_mctx);
+                fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_q_numref(F),
+                    fmpz_mpoly_q_numref(CA_MPOLY_Q(res)), gen_map, mctx, new_mctx);
+                fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_q_denref(F),
+                    fmpz_mpoly_q_denref(CA_MPOLY_Q(res)), gen_map, mctx, new_mctx);
+
+                _ca_make_field_element(res, new_field, ctx);
+                fmpz_mpoly_q_swap(CA_MPOLY_Q(res), F, new_mctx);
+                fmpz_mpoly_q_clear(F, new_mctx);
+
+                /* the ideal of the subfield may contain relations that
+                   were not visible in the larger field */
+                _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), new_field, ctx);
+                _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), new_field, ctx);
+                ca_condense_field(res, ctx);
+            }
 
             TMP_END;
         }
@@ -239,6 +239,44 @@ void nf_elem_conj_imag(nf_elem_t a, const nf_elem_t b, const nf_t nf)
     }
 }
 
+/* Applies the automorphism a -> a^k where the generator a is a primitive
+   q-th root of unity and gcd(k, q) = 1. Since a^q = 1, this just moves
+   the coefficient of a^i to a^(k i mod q), followed by a single
+   reduction modulo the cyclotomic polynomial. */
+static void
+nf_elem_cyclotomic_automorphism(nf_elem_t a, const nf_elem_t b, ulong k, ulong q, const nf_t nf)
+{
+    fmpq_poly_t s, t;
+    ulong e;
+    slong i;
+
+    fmpq_poly_init(s);
+    fmpq_poly_init(t);
+
+    nf_elem_get_fmpq_poly(s, b, nf);
+
+    fmpq_poly_fit_length(t, q);
+    _fmpz_vec_zero(t->coeffs, q);
+
+    for (i = 0, e = 0; i < s->length; i++)
+    {
+        fmpz_set(t->coeffs + e, s->coeffs + i);
+        e += k;
+        if (e >= q)
+            e -= q;
+    }
+
+    fmpz_set(t->den, s->den);
+    _fmpq_poly_set_length(t, q);
+    _fmpq_poly_normalise(t);
+
+    fmpq_poly_rem(t, t, nf->pol);
+    nf_elem_set_fmpq_poly(a, t, nf);
+
+    fmpq_poly_clear(s);
+    fmpq_poly_clear(t);
+}
+
 void
 ca_conj_deep(ca_t res, const ca_t x, ca_ctx_t ctx)
 {
@@ -277,23 +315,9 @@ ca_conj_deep(ca_t res, const ca_t x, ca_ctx_t ctx)
             }
             else if (ca_is_cyclotomic_nf_elem(&p, &q, x, ctx))
             {
-                nf_struct * nf;
-                fmpq_poly_t poly;
-
-                nf = CA_FIELD_NF(CA_FIELD(x, ctx));
-
-                fmpq_poly_init(poly);
-
-                nf_elem_get_fmpq_poly(poly, CA_NF_ELEM(x), nf);
-
                 ca_set(res, x, ctx);
-                nf_elem_gen(CA_NF_ELEM(res), nf);
-                nf_elem_pow(CA_NF_ELEM(res), CA_NF_ELEM(res), q - 1, nf);
+                nf_elem_cyclotomic_automorphism(CA_NF_ELEM(res), CA_NF_ELEM(x), q - 1, q, CA_FIELD_NF(K));
                 ca_condense_field(res, ctx);
-
-                ca_fmpq_poly_evaluate(res, poly, res, ctx);
-
-                fmpq_poly_clear(poly);
             }
             else
             {
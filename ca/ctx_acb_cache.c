@@ -0,0 +1,124 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+/* The memo is a direct-mapped table: each element can only occupy the
+   slot given by its hash, and a new enclosure replaces whatever was
+   there. Entries hold references to their fields; the table is emptied
+   by cache sweeps so that those fields can be evicted. */
+
+void
+_ca_ctx_clear_acb_cache(ca_ctx_t ctx)
+{
+    slong i;
+
+    ca_ctx_lock(ctx);
+
+    for (i = 0; i < ctx->acb_cache_size; i++)
+    {
+        ca_clear(&ctx->acb_cache[i].x, ctx);
+        acb_clear(&ctx->acb_cache[i].enclosure);
+    }
+
+    flint_free(ctx->acb_cache);
+    ctx->acb_cache = NULL;
+    ctx->acb_cache_size = 0;
+
+    ca_ctx_unlock(ctx);
+}
+
+/* Returns the slot for hash, (re)allocating the table if the
+   size option has changed, or NULL if the memo is disabled.
+   The caller must hold the lock. */
+static ca_acb_cache_entry_struct *
+_ca_ctx_acb_cache_slot(ulong hash, ca_ctx_t ctx)
+{
+    slong i, size;
+
+    if (ctx->options[CA_OPT_ACB_CACHE_SIZE] <= 0)
+        return NULL;
+
+    size = 1;
+    while (size < ctx->options[CA_OPT_ACB_CACHE_SIZE])
+        size *= 2;
+
+    if (size != ctx->acb_cache_size)
+    {
+        _ca_ctx_clear_acb_cache(ctx);
+
+        ctx->acb_cache = flint_malloc(sizeof(ca_acb_cache_entry_struct) * size);
+
+        for (i = 0; i < size; i++)
+        {
+            ctx->acb_cache[i].hash = 0;
+            ctx->acb_cache[i].prec = 0;
+            ca_init(&ctx->acb_cache[i].x, ctx);
+            acb_init(&ctx->acb_cache[i].enclosure);
+        }
+
+        ctx->acb_cache_size = size;
+    }
+
+    return ctx->acb_cache + (hash & (size - 1));
+}
+
+int
+_ca_ctx_acb_cache_lookup(acb_t res, const ca_t x, ulong hash, slong prec, ca_ctx_t ctx)
+{
+    ca_acb_cache_entry_struct * entry;
+    int found;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_acb_cache_slot(hash, ctx);
+
+    found = (entry != NULL && entry->prec >= prec && entry->hash == hash &&
+        ca_equal_repr(&entry->x, x, ctx));
+
+    if (found)
+    {
+        acb_set_round(res, &entry->enclosure, prec);
+        CA_CTX_STATS_ADD(ctx, acb_cache_hits, 1);
+    }
+    else if (entry != NULL)
+    {
+        CA_CTX_STATS_ADD(ctx, acb_cache_misses, 1);
+    }
+
+    ca_ctx_unlock(ctx);
+
+    return found;
+}
+
+void
+_ca_ctx_acb_cache_insert(const ca_t x, ulong hash, const acb_t v, slong prec, ca_ctx_t ctx)
+{
+    ca_acb_cache_entry_struct * entry;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_acb_cache_slot(hash, ctx);
+
+    if (entry != NULL)
+    {
+        /* keep a more precise enclosure of the same element */
+        if (entry->prec <= prec || entry->hash != hash || !ca_equal_repr(&entry->x, x, ctx))
+        {
+            entry->hash = hash;
+            entry->prec = prec;
+            ca_set(&entry->x, x, ctx);
+            acb_set(&entry->enclosure, v);
+        }
+    }
+
+    ca_ctx_unlock(ctx);
+}
@@ -0,0 +1,66 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+/* needed for clock_gettime with -ansi */
+#define _XOPEN_SOURCE 700
+
+#include <time.h>
+#include "ca.h"
+
+static double
+_ca_wall_time_ms(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec * 1e-6;
+#else
+    return clock() * (1000.0 / CLOCKS_PER_SEC);
+#endif
+}
+
+void
+ca_ctx_budget_start(ca_ctx_t ctx)
+{
+    ctx->budget_work = 0;
+    ctx->budget_exceeded = 0;
+    ctx->budget_start = _ca_wall_time_ms();
+}
+
+void
+_ca_ctx_budget_charge(ca_ctx_t ctx, slong units)
+{
+#if FLINT_USES_PTHREAD && defined(__GNUC__)
+    if (ctx->options[CA_OPT_THREAD_SAFE])
+        __sync_add_and_fetch(&ctx->budget_work, units);
+    else
+#endif
+        ctx->budget_work += units;
+}
+
+int
+ca_ctx_budget_exceeded(ca_ctx_t ctx)
+{
+    slong work_limit, time_limit;
+
+    if (ctx->budget_exceeded)
+        return 1;
+
+    work_limit = ctx->options[CA_OPT_WORK_LIMIT];
+    time_limit = ctx->options[CA_OPT_TIME_LIMIT];
+
+    if (work_limit > 0 && ctx->budget_work > work_limit)
+        ctx->budget_exceeded = 1;
+    else if (time_limit > 0 && _ca_wall_time_ms() - ctx->budget_start > time_limit)
+        ctx->budget_exceeded = 1;
+
+    return ctx->budget_exceeded;
+}
@@ -0,0 +1,45 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+slong
+ca_ctx_cache_allocated_bytes(ca_ctx_t ctx)
+{
+    slong i, size;
+
+    ca_ctx_lock(ctx);
+
+    size = 0;
+
+    for (i = 0; i < CA_CTX_EXT_CACHE(ctx)->length; i++)
+        size += ca_ext_allocated_bytes(CA_CTX_EXT_CACHE(ctx)->items[i], ctx);
+
+    for (i = 0; i < CA_CTX_FIELD_CACHE(ctx)->length; i++)
+        size += ca_field_allocated_bytes(CA_CTX_FIELD_CACHE(ctx)->items[i], ctx);
+
+    /* unused preallocated entries */
+    size += (CA_CTX_EXT_CACHE(ctx)->alloc - CA_CTX_EXT_CACHE(ctx)->length) * sizeof(ca_ext_struct);
+    size += (CA_CTX_FIELD_CACHE(ctx)->alloc - CA_CTX_FIELD_CACHE(ctx)->length) * sizeof(ca_field_struct);
+
+    size += CA_CTX_EXT_CACHE(ctx)->alloc * sizeof(ca_ext_struct *);
+    size += CA_CTX_FIELD_CACHE(ctx)->alloc * sizeof(ca_field_struct *);
+    size += CA_CTX_EXT_CACHE(ctx)->hash_size * sizeof(slong);
+    size += CA_CTX_FIELD_CACHE(ctx)->hash_size * sizeof(slong);
+
+    size += ctx->mctx_len * (sizeof(fmpz_mpoly_ctx_struct *) + sizeof(fmpz_mpoly_ctx_struct));
+
+    ca_ctx_unlock(ctx);
+
+    return size;
+}
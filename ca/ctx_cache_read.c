@@ -0,0 +1,590 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+#include "ca_vec.h"
+
+/* see ctx_cache_write.c for a description of the format */
+
+#define CA_CACHE_FORMAT_VERSION 2
+
+
+typedef struct
+{
+    const char * s;
+    slong pos;
+    slong len;
+    char * tok;
+    slong alloc;
+    ca_ext_struct ** ext;
+    slong ext_len;
+    ca_field_struct ** field;
+    slong field_len;
+}
+_ca_cache_reader_struct;
+
+typedef _ca_cache_reader_struct _ca_cache_reader_t[1];
+
+/* FNV-1a */
+ulong
+_ca_ctx_cache_checksum(const char * s, slong len)
+{
+    ulong h;
+    slong i;
+
+    h = UWORD(2166136261);
+
+    for (i = 0; i < len; i++)
+    {
+        h ^= (unsigned char) s[i];
+        h *= UWORD(16777619);
+    }
+
+    return h;
+}
+
+static const char *
+_next(_ca_cache_reader_t R)
+{
+    slong start;
+
+    while (R->pos < R->len && (R->s[R->pos] == ' ' || R->s[R->pos] == '\n'))
+        R->pos++;
+
+    if (R->pos == R->len)
+        return NULL;
+
+    start = R->pos;
+    while (R->pos < R->len && R->s[R->pos] != ' ' && R->s[R->pos] != '\n')
+        R->pos++;
+
+    if (R->pos - start + 1 > R->alloc)
+    {
+        R->alloc = FLINT_MAX(R->pos - start + 1, 2 * R->alloc);
+        R->tok = flint_realloc(R->tok, R->alloc);
+    }
+
+    memcpy(R->tok, R->s + start, R->pos - start);
+    R->tok[R->pos - start] = '\0';
+
+    return R->tok;
+}
+
+static int
+_read_fmpz(fmpz_t res, _ca_cache_reader_t R)
+{
+    const char * t = _next(R);
+    return (t != NULL) && (fmpz_set_str(res, t, 10) == 0);
+}
+
+static int
+_read_si(slong * res, slong lo, slong hi, _ca_cache_reader_t R)
+{
+    fmpz_t t;
+    int success;
+
+    fmpz_init(t);
+    success = _read_fmpz(t, R) && fmpz_cmp_si(t, lo) >= 0 && fmpz_cmp_si(t, hi) <= 0;
+    if (success)
+        *res = fmpz_get_si(t);
+    fmpz_clear(t);
+
+    return success;
+}
+
+static int
+_read_arb(arb_t res, _ca_cache_reader_t R)
+{
+    char * s;
+    const char * t;
+    slong i, len;
+    int success;
+
+    s = NULL;
+    len = 0;
+    success = 1;
+
+    for (i = 0; i < 4 && success; i++)
+    {
+        t = _next(R);
+
+        if (t == NULL)
+        {
+            success = 0;
+        }
+        else
+        {
+            s = flint_realloc(s, len + strlen(t) + 2);
+            if (i != 0)
+                s[len++] = ' ';
+            strcpy(s + len, t);
+            len += strlen(t);
+        }
+    }
+
+    if (success)
+        success = (arb_load_str(res, s) == 0);
+
+    flint_free(s);
+    return success;
+}
+
+static int
+_read_acb(acb_t res, _ca_cache_reader_t R)
+{
+    return _read_arb(acb_realref(res), R) && _read_arb(acb_imagref(res), R);
+}
+
+static int
+_read_mpoly(fmpz_mpoly_t res, const fmpz_mpoly_ctx_t mctx, _ca_cache_reader_t R)
+{
+    slong i, j, len, nvars;
+    ulong * exp;
+    fmpz_t c, e;
+    int success;
+
+    nvars = mctx->minfo->nvars;
+
+    if (!_read_si(&len, 0, WORD_MAX, R))
+        return 0;
+
+    exp = flint_malloc(sizeof(ulong) * nvars);
+    fmpz_init(c);
+    fmpz_init(e);
+    success = 1;
+
+    fmpz_mpoly_zero(res, mctx);
+
+    for (i = 0; i < len && success; i++)
+    {
+        success = _read_fmpz(c, R) && !fmpz_is_zero(c);
+
+        for (j = 0; j < nvars && success; j++)
+        {
+            success = _read_fmpz(e, R) && fmpz_sgn(e) >= 0 && fmpz_abs_fits_ui(e);
+            if (success)
+                exp[j] = fmpz_get_ui(e);
+        }
+
+        if (success)
+            fmpz_mpoly_push_term_fmpz_ui(res, c, exp, mctx);
+    }
+
+    if (success)
+    {
+        fmpz_mpoly_sort_terms(res, mctx);
+        fmpz_mpoly_combine_like_terms(res, mctx);
+        success = (fmpz_mpoly_length(res, mctx) == len);
+    }
+
+    flint_free(exp);
+    fmpz_clear(c);
+    fmpz_clear(e);
+
+    return success;
+}
+
+static int
+_read_elem(ca_t res, _ca_cache_reader_t R, ca_ctx_t ctx)
+{
+    const char * t;
+    ca_field_ptr K;
+    slong i, id;
+    int inf, success;
+
+    t = _next(R);
+
+    if (t == NULL)
+        return 0;
+
+    if (strcmp(t, "u") == 0)
+    {
+        ca_unknown(res, ctx);
+        return 1;
+    }
+
+    if (strcmp(t, "d") == 0)
+    {
+        ca_undefined(res, ctx);
+        return 1;
+    }
+
+    if (strcmp(t, "o") == 0)
+    {
+        ca_uinf(res, ctx);
+        return 1;
+    }
+
+    if (strcmp(t, "e") == 0)
+        inf = 0;
+    else if (strcmp(t, "i") == 0)
+        inf = 1;
+    else
+        return 0;
+
+    if (!_read_si(&id, 0, R->field_len - 1, R))
+        return 0;
+
+    K = R->field[id];
+
+    if (CA_FIELD_IS_QQ(K))
+    {
+        fmpq_t q;
+
+        fmpq_init(q);
+        success = _read_fmpz(fmpq_numref(q), R) && _read_fmpz(fmpq_denref(q), R) &&
+            fmpz_sgn(fmpq_denref(q)) > 0 && fmpq_is_canonical(q);
+        if (success)
+            ca_set_fmpq(res, q, ctx);
+        fmpq_clear(q);
+    }
+    else if (CA_FIELD_IS_NF(K))
+    {
+        fmpq_poly_t p;
+        slong len;
+
+        fmpq_poly_init(p);
+        success = _read_si(&len, 0, qqbar_degree(CA_FIELD_NF_QQBAR(K)) - 1, R);
+
+        if (success)
+        {
+            fmpq_poly_fit_length(p, len);
+            for (i = 0; i < len && success; i++)
+                success = _read_fmpz(p->coeffs + i, R);
+            _fmpq_poly_set_length(p, len);
+            success = success && _read_fmpz(fmpq_poly_denref(p), R) && !fmpz_is_zero(fmpq_poly_denref(p));
+        }
+
+        if (success)
+        {
+            fmpq_poly_canonicalise(p);
+            _ca_make_field_element(res, K, ctx);
+            nf_elem_set_fmpq_poly(CA_NF_ELEM(res), p, CA_FIELD_NF(K));
+        }
+
+        fmpq_poly_clear(p);
+    }
+    else
+    {
+        fmpz_mpoly_q_t f;
+        fmpz_mpoly_ctx_struct * mctx = CA_FIELD_MCTX(K, ctx);
+
+        fmpz_mpoly_q_init(f, mctx);
+        success = _read_mpoly(fmpz_mpoly_q_numref(f), mctx, R) &&
+                  _read_mpoly(fmpz_mpoly_q_denref(f), mctx, R) &&
+                  fmpz_mpoly_q_is_canonical(f, mctx);
+
+        if (success)
+        {
+            _ca_make_field_element(res, K, ctx);
+            fmpz_mpoly_q_swap(CA_MPOLY_Q(res), f, mctx);
+        }
+
+        fmpz_mpoly_q_clear(f, mctx);
+    }
+
+    if (success && inf)
+    {
+        if (ca_check_is_zero(res, ctx) != T_FALSE)
+            return 0;
+
+        res->field |= CA_INF;
+    }
+
+    return success;
+}
+
+static int
+_read_ext_qqbar(_ca_cache_reader_t R, ca_ctx_t ctx)
+{
+    qqbar_t x;
+    fmpz_t c;
+    slong i, len;
+    int success;
+
+    if (!_read_si(&len, 2, WORD_MAX, R))
+        return 0;
+
+    qqbar_init(x);
+    fmpz_init(c);
+
+    fmpz_poly_fit_length(QQBAR_POLY(x), len);
+    success = 1;
+    for (i = 0; i < len && success; i++)
+        success = _read_fmpz(QQBAR_POLY(x)->coeffs + i, R);
+    _fmpz_poly_set_length(QQBAR_POLY(x), len);
+
+    success = success && _read_acb(QQBAR_ENCLOSURE(x), R);
+
+    if (success)
+    {
+        fmpz_poly_content(c, QQBAR_POLY(x));
+
+        success = fmpz_is_one(c) && fmpz_sgn(QQBAR_POLY(x)->coeffs + len - 1) > 0 &&
+            _qqbar_validate_existence_uniqueness(NULL, QQBAR_POLY(x), QQBAR_ENCLOSURE(x),
+                FLINT_MAX(2 * acb_rel_accuracy_bits(QQBAR_ENCLOSURE(x)), ctx->options[CA_OPT_LOW_PREC]));
+    }
+
+    if (success)
+    {
+        ca_ext_t tmp;
+
+        ca_ext_init_qqbar(tmp, x, ctx);
+        R->ext[R->ext_len++] = ca_ext_cache_insert(CA_CTX_EXT_CACHE(ctx), tmp, ctx);
+        ca_ext_clear(tmp, ctx);
+    }
+
+    qqbar_clear(x);
+    fmpz_clear(c);
+
+    return success;
+}
+
+static int
+_read_ext_func(_ca_cache_reader_t R, ca_ctx_t ctx)
+{
+    const char * t;
+    calcium_func_code f;
+    slong i, nargs, prec;
+    ca_ptr args;
+    acb_t z, w;
+    int success;
+
+    t = _next(R);
+
+    if (t == NULL)
+        return 0;
+
+    for (f = 0; f < CA_FUNC_CODE_LENGTH; f++)
+        if (strcmp(calcium_func_name(f), t) == 0)
+            break;
+
+    if (f == CA_FUNC_CODE_LENGTH || f == CA_QQBar)
+        return 0;
+
+    if (!_read_si(&nargs, 0, 1000, R))
+        return 0;
+
+    args = _ca_vec_init(nargs, ctx);
+    acb_init(z);
+    acb_init(w);
+
+    success = 1;
+    for (i = 0; i < nargs && success; i++)
+        success = _read_elem(args + i, R, ctx);
+
+    success = success && _read_si(&prec, 0, WORD_MAX, R) && _read_acb(z, R);
+
+    if (success)
+    {
+        ca_ext_t tmp;
+        ca_ext_ptr x;
+
+        ca_ext_init_fxn(tmp, f, args, nargs, ctx);
+        x = ca_ext_cache_insert(CA_CTX_EXT_CACHE(ctx), tmp, ctx);
+        ca_ext_clear(tmp, ctx);
+
+        R->ext[R->ext_len++] = x;
+
+        if (prec > CA_EXT_FUNC_PREC(x) && CA_CTX_OWNS(x, ctx))
+        {
+            /* do not trust the stored enclosure blindly */
+            ca_ext_get_acb_raw(w, x, ctx->options[CA_OPT_LOW_PREC], ctx);
+
+            if (acb_is_finite(w) && !acb_overlaps(w, z))
+            {
+                success = 0;
+            }
+            else
+            {
+                ca_ctx_lock(ctx);
+                if (prec > CA_EXT_FUNC_PREC(x))
+                {
+                    acb_swap(CA_EXT_FUNC_ENCLOSURE(x), z);
+                    CA_EXT_FUNC_PREC(x) = prec;
+                }
+                ca_ctx_unlock(ctx);
+            }
+        }
+    }
+
+    _ca_vec_clear(args, nargs, ctx);
+    acb_clear(z);
+    acb_clear(w);
+
+    return success;
+}
+
+/* The reduction ideal is not part of the snapshot: relations that only
+   vanish numerically could make zero tests return wrong answers, and
+   checking them exactly costs about as much as rebuilding the ideal. */
+static int
+_read_field(_ca_cache_reader_t R, ca_ctx_t ctx)
+{
+    ca_ext_struct ** ext;
+    slong i, len, id;
+    int success;
+
+    if (!_read_si(&len, 0, R->ext_len, R))
+        return 0;
+
+    ext = flint_malloc(sizeof(ca_ext_struct *) * FLINT_MAX(len, 1));
+
+    success = 1;
+    for (i = 0; i < len && success; i++)
+    {
+        success = _read_si(&id, 0, R->ext_len - 1, R);
+
+        if (success)
+        {
+            ext[i] = R->ext[id];
+
+            /* generators are sorted, more complex first */
+            if (i > 0 && ca_ext_cmp_repr(ext[i - 1], ext[i], ctx) <= 0)
+                success = 0;
+        }
+    }
+
+    if (success)
+    {
+        if (len == 0)
+            R->field[R->field_len++] = ctx->field_qq;
+        else
+            R->field[R->field_len++] = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), ext, len, ctx);
+    }
+
+    flint_free(ext);
+    return success;
+}
+
+int
+ca_ctx_cache_read(ca_ctx_t ctx, const char * data, slong len)
+{
+    _ca_cache_reader_t R;
+    const char * t;
+    slong i, pos, n, version, ord;
+    fmpz_t c;
+    int success;
+
+    /* locate and verify the trailer */
+    for (pos = len - 4; pos >= 0; pos--)
+        if ((pos == 0 || data[pos - 1] == '\n') && strncmp(data + pos, "end ", 4) == 0)
+            break;
+
+    if (pos < 0)
+        return 0;
+
+    R->s = data;
+    R->pos = pos + 4;
+    R->len = len;
+    R->tok = NULL;
+    R->alloc = 0;
+
+    fmpz_init(c);
+    success = _read_fmpz(c, R) && fmpz_abs_fits_ui(c) && fmpz_sgn(c) >= 0 &&
+        fmpz_get_ui(c) == _ca_ctx_cache_checksum(data, pos) && _next(R) == NULL;
+    fmpz_clear(c);
+
+    if (!success)
+    {
+        flint_free(R->tok);
+        return 0;
+    }
+
+    /* header */
+    R->pos = 0;
+    R->len = pos;
+
+    t = _next(R);
+    success = (t != NULL) && (strcmp(t, "calcium-cache") == 0);
+    success = success && _read_si(&version, 0, WORD_MAX, R) && version == CA_CACHE_FORMAT_VERSION;
+    t = success ? _next(R) : NULL;
+    success = success && (t != NULL) && (strcmp(t, CALCIUM_VERSION) == 0);
+    success = success && _read_si(&ord, 0, WORD_MAX, R) && ord == ctx->options[CA_OPT_MPOLY_ORD];
+
+    if (!success)
+    {
+        flint_free(R->tok);
+        return 0;
+    }
+
+    /* every record starts with a one-character token on a new line */
+    n = 0;
+    for (i = 0; i < pos; i++)
+        n += (data[i] == '\n');
+
+    R->ext = flint_malloc(sizeof(ca_ext_struct *) * FLINT_MAX(n, 1));
+    R->field = flint_malloc(sizeof(ca_field_struct *) * FLINT_MAX(n, 1));
+    R->ext_len = R->field_len = 0;
+
+    while (success && (t = _next(R)) != NULL)
+    {
+        if (strcmp(t, "x") == 0)
+        {
+            t = _next(R);
+
+            if (t != NULL && strcmp(t, "q") == 0)
+                success = _read_ext_qqbar(R, ctx);
+            else if (t != NULL && strcmp(t, "f") == 0)
+                success = _read_ext_func(R, ctx);
+            else
+                success = 0;
+        }
+        else if (strcmp(t, "k") == 0)
+        {
+            success = _read_field(R, ctx);
+        }
+        else
+        {
+            success = 0;
+        }
+    }
+
+    if (!success)
+        CA_INFO(ctx, ("rejected cache snapshot after %wd extension numbers and %wd fields\n", R->ext_len, R->field_len));
+
+    flint_free(R->tok);
+    flint_free(R->ext);
+    flint_free(R->field);
+
+    return success;
+}
+
+int
+ca_ctx_cache_fread(ca_ctx_t ctx, FILE * fp)
+{
+    char * data;
+    slong len, alloc, n;
+    int success;
+
+    alloc = 4096;
+    len = 0;
+    data = flint_malloc(alloc);
+
+    while ((n = fread(data + len, 1, alloc - len, fp)) > 0)
+    {
+        len += n;
+
+        if (len == alloc)
+        {
+            alloc *= 2;
+            data = flint_realloc(data, alloc);
+        }
+    }
+
+    success = ca_ctx_cache_read(ctx, data, len);
+
+    flint_free(data);
+    return success;
+}
@@ -0,0 +1,203 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+#define INITIAL_HASH_SIZE 16
+
+ulong ca_field_hash(const ca_field_t K, ca_ctx_t ctx);
+
+static slong *
+_hash_table_build(slong * size, const ulong * hashes, slong len)
+{
+    slong i, j, n;
+    slong * table;
+
+    n = INITIAL_HASH_SIZE;
+    while (len >= 0.25 * n)
+        n *= 2;
+
+    table = flint_malloc(sizeof(slong) * n);
+    for (i = 0; i < n; i++)
+        table[i] = -1;
+
+    for (i = 0; i < len; i++)
+    {
+        j = hashes[i] % ((ulong) n);
+
+        while (table[j] != -1)
+        {
+            j++;
+            if (j == n)
+                j = 0;
+        }
+
+        table[j] = i;
+    }
+
+    *size = n;
+    return table;
+}
+
+static void
+_ca_ext_cache_compact(ca_ext_cache_t cache, ca_ctx_t ctx)
+{
+    slong i, len;
+    ulong * hashes;
+
+    for (i = cache->length; i < cache->alloc; i++)
+        flint_free(cache->items[i]);
+
+    len = 0;
+    for (i = 0; i < cache->length; i++)
+        if (cache->items[i] != NULL)
+            cache->items[len++] = cache->items[i];
+
+    cache->items = flint_realloc(cache->items, FLINT_MAX(len, 1) * sizeof(ca_ext_struct *));
+    cache->length = cache->alloc = len;
+
+    hashes = flint_malloc(FLINT_MAX(len, 1) * sizeof(ulong));
+    for (i = 0; i < len; i++)
+        hashes[i] = ca_ext_hash(cache->items[i], ctx);
+
+    flint_free(cache->hash_table);
+    cache->hash_table = _hash_table_build(&cache->hash_size, hashes, len);
+    flint_free(hashes);
+}
+
+static void
+_ca_field_cache_compact(ca_field_cache_t cache, ca_ctx_t ctx)
+{
+    slong i, len;
+    ulong * hashes;
+
+    for (i = cache->length; i < cache->alloc; i++)
+        flint_free(cache->items[i]);
+
+    len = 0;
+    for (i = 0; i < cache->length; i++)
+        if (cache->items[i] != NULL)
+            cache->items[len++] = cache->items[i];
+
+    cache->items = flint_realloc(cache->items, FLINT_MAX(len, 1) * sizeof(ca_field_struct *));
+    cache->length = cache->alloc = len;
+
+    hashes = flint_malloc(FLINT_MAX(len, 1) * sizeof(ulong));
+    for (i = 0; i < len; i++)
+        hashes[i] = ca_field_hash(cache->items[i], ctx);
+
+    flint_free(cache->hash_table);
+    cache->hash_table = _hash_table_build(&cache->hash_size, hashes, len);
+    flint_free(hashes);
+}
+
+/*
+    Evicts fields that are not referenced by any element and extension
+    numbers that are not generators of any cached field. Evicting an
+    extension number releases its arguments, which may in turn make
+    further fields unreferenced, so we iterate until nothing changes.
+
+    With full = 0, only entries that have not been used since the
+    previous sweep are evicted. This protects pointers to fresh fields
+    that the caller has not yet attached to an element.
+*/
+void
+_ca_ctx_cache_sweep(ca_ctx_t ctx, int full)
+{
+    ca_ext_cache_struct * ext_cache;
+    ca_field_cache_struct * field_cache;
+    ca_field_ptr K;
+    ca_ext_ptr E;
+    slong i, j, num_fields, num_ext;
+    int changed;
+
+    /* forks may be reading the caches */
+    if (ctx->fork_count != 0)
+        return;
+
+    ca_ctx_lock(ctx);
+
+    /* memoized enclosures and results hold references to fields */
+    _ca_ctx_clear_acb_cache(ctx);
+    _ca_ctx_clear_op_cache(ctx);
+    _ca_ctx_clear_merge_cache(ctx);
+    _ca_ctx_clear_primitive_cache(ctx);
+
+    ext_cache = CA_CTX_EXT_CACHE(ctx);
+    field_cache = CA_CTX_FIELD_CACHE(ctx);
+
+    num_fields = num_ext = 0;
+
+    do
+    {
+        changed = 0;
+
+        for (i = field_cache->length - 1; i >= 0; i--)
+        {
+            K = field_cache->items[i];
+
+            if (K == NULL || K == ctx->field_qq || K == ctx->field_qq_i)
+                continue;
+
+            if (K->refcount == 0 && (full || K->gen < ctx->cache_gen))
+            {
+                for (j = 0; j < CA_FIELD_LENGTH(K); j++)
+                    if (CA_CTX_OWNS(CA_FIELD_EXT_ELEM(K, j), ctx))
+                        CA_FIELD_EXT_ELEM(K, j)->refcount--;
+
+                ca_field_clear(K, ctx);
+                flint_free(K);
+                field_cache->items[i] = NULL;
+                num_fields++;
+                changed = 1;
+            }
+        }
+
+        /* reverse order ensures that we free f(x) before freeing any
+           element used by x */
+        for (i = ext_cache->length - 1; i >= 0; i--)
+        {
+            E = ext_cache->items[i];
+
+            if (E == NULL)
+                continue;
+
+            if (E->refcount == 0 && (full || E->gen < ctx->cache_gen))
+            {
+                ca_ext_clear(E, ctx);
+                flint_free(E);
+                ext_cache->items[i] = NULL;
+                num_ext++;
+                changed = 1;
+            }
+        }
+    }
+    while (changed);
+
+    _ca_ext_cache_compact(ext_cache, ctx);
+    _ca_field_cache_compact(field_cache, ctx);
+
+    CA_INFO(ctx, ("cache sweep: evicted %wd extension numbers and %wd fields\n", num_ext, num_fields));
+
+    ctx->cache_bytes = ca_ctx_cache_allocated_bytes(ctx);
+    ctx->cache_gen++;
+    ctx->cache_sweep_countdown = field_cache->length / 4 + 16;
+
+    ca_ctx_unlock(ctx);
+}
+
+void
+ca_ctx_cache_sweep(ca_ctx_t ctx)
+{
+    _ca_ctx_cache_sweep(ctx, 1);
+}
@@ -0,0 +1,348 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+/*
+    Snapshot format (version 2). All tokens are separated by whitespace,
+    and each record starts on a new line:
+
+        calcium-cache <format version> <library version> <monomial order>
+        x q <n> <c_0> ... <c_{n-1}> <enclosure>
+        x f <function name> <nargs> <arg> ... <arg> <prec> <enclosure>
+        k <length> <ext> ... <ext>
+        end <checksum>
+
+    Extension numbers (x) and fields (k) are numbered separately in the
+    order they appear, and only refer to earlier records. An enclosure is
+    written as two arb_dump_str strings. A function argument is one of
+    u (Unknown), d (Undefined), o (unsigned infinity), or e (element) or
+    i (signed infinity) followed by a field number and the element data.
+    The checksum is a hash of all preceding characters. Reduction ideals
+    are not stored, since a snapshot is not trusted to contain valid
+    relations; they are rebuilt when the fields are loaded.
+*/
+
+#define CA_CACHE_FORMAT_VERSION 2
+
+typedef struct
+{
+    ulong key;
+    slong id;
+}
+_ptr_id_struct;
+
+typedef struct
+{
+    _ptr_id_struct * ext;
+    slong ext_len;
+    slong ext_next;
+    _ptr_id_struct * field;
+    slong field_len;
+    slong field_next;
+}
+_ca_cache_writer_struct;
+
+static int
+_ptr_id_cmp(const void * a, const void * b)
+{
+    ulong x = ((const _ptr_id_struct *) a)->key;
+    ulong y = ((const _ptr_id_struct *) b)->key;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static _ptr_id_struct *
+_ptr_id_find(_ptr_id_struct * tab, slong len, const void * ptr)
+{
+    _ptr_id_struct key;
+    key.key = (ulong) ptr;
+    return bsearch(&key, tab, len, sizeof(_ptr_id_struct), _ptr_id_cmp);
+}
+
+static void
+_write_ui(calcium_stream_t out, ulong x)
+{
+    fmpz_t t;
+    fmpz_init_set_ui(t, x);
+    calcium_write_fmpz(out, t);
+    fmpz_clear(t);
+}
+
+static void
+_write_arb(calcium_stream_t out, const arb_t x)
+{
+    calcium_write(out, " ");
+    calcium_write_free(out, arb_dump_str(x));
+}
+
+static void
+_write_mpoly(calcium_stream_t out, const fmpz_mpoly_t f, const fmpz_mpoly_ctx_t mctx)
+{
+    slong i, j, nvars;
+    ulong * exp;
+    fmpz_t c;
+
+    nvars = mctx->minfo->nvars;
+    exp = flint_malloc(sizeof(ulong) * nvars);
+    fmpz_init(c);
+
+    calcium_write(out, " ");
+    calcium_write_si(out, fmpz_mpoly_length(f, mctx));
+
+    for (i = 0; i < fmpz_mpoly_length(f, mctx); i++)
+    {
+        fmpz_mpoly_get_term_coeff_fmpz(c, f, i, mctx);
+        fmpz_mpoly_get_term_exp_ui(exp, f, i, mctx);
+
+        calcium_write(out, " ");
+        calcium_write_fmpz(out, c);
+
+        for (j = 0; j < nvars; j++)
+        {
+            calcium_write(out, " ");
+            _write_ui(out, exp[j]);
+        }
+    }
+
+    flint_free(exp);
+    fmpz_clear(c);
+}
+
+static void _write_field(calcium_stream_t out, _ca_cache_writer_struct * W, ca_field_srcptr K, ca_ctx_t ctx);
+
+static void
+_write_elem(calcium_stream_t out, _ca_cache_writer_struct * W, const ca_t x, ca_ctx_t ctx)
+{
+    ca_field_srcptr K;
+
+    if (CA_IS_UNKNOWN(x))
+    {
+        calcium_write(out, " u");
+        return;
+    }
+
+    if (CA_IS_UNDEFINED(x))
+    {
+        calcium_write(out, " d");
+        return;
+    }
+
+    if (CA_IS_UNSIGNED_INF(x))
+    {
+        calcium_write(out, " o");
+        return;
+    }
+
+    K = CA_FIELD_UNSPECIAL(x, ctx);
+
+    calcium_write(out, CA_IS_SIGNED_INF(x) ? " i " : " e ");
+    calcium_write_si(out, _ptr_id_find(W->field, W->field_len, K)->id);
+
+    if (CA_FIELD_IS_QQ(K))
+    {
+        calcium_write(out, " ");
+        calcium_write_fmpz(out, CA_FMPQ_NUMREF(x));
+        calcium_write(out, " ");
+        calcium_write_fmpz(out, CA_FMPQ_DENREF(x));
+    }
+    else if (CA_FIELD_IS_NF(K))
+    {
+        fmpq_poly_t t;
+        slong i;
+
+        fmpq_poly_init(t);
+        nf_elem_get_fmpq_poly(t, CA_NF_ELEM(x), CA_FIELD_NF(K));
+
+        calcium_write(out, " ");
+        calcium_write_si(out, fmpq_poly_length(t));
+
+        for (i = 0; i < fmpq_poly_length(t); i++)
+        {
+            calcium_write(out, " ");
+            calcium_write_fmpz(out, t->coeffs + i);
+        }
+
+        calcium_write(out, " ");
+        calcium_write_fmpz(out, fmpq_poly_denref(t));
+
+        fmpq_poly_clear(t);
+    }
+    else
+    {
+        _write_mpoly(out, fmpz_mpoly_q_numref(CA_MPOLY_Q(x)), CA_FIELD_MCTX(K, ctx));
+        _write_mpoly(out, fmpz_mpoly_q_denref(CA_MPOLY_Q(x)), CA_FIELD_MCTX(K, ctx));
+    }
+}
+
+static void
+_write_ext(calcium_stream_t out, _ca_cache_writer_struct * W, ca_ext_srcptr x, ca_ctx_t ctx)
+{
+    _ptr_id_struct * entry;
+    slong i;
+
+    entry = _ptr_id_find(W->ext, W->ext_len, x);
+
+    if (entry->id != -1)
+        return;
+
+    if (CA_EXT_IS_QQBAR(x))
+    {
+        const fmpz_poly_struct * poly = QQBAR_POLY(CA_EXT_QQBAR(x));
+
+        calcium_write(out, "x q ");
+        calcium_write_si(out, poly->length);
+
+        for (i = 0; i < poly->length; i++)
+        {
+            calcium_write(out, " ");
+            calcium_write_fmpz(out, poly->coeffs + i);
+        }
+
+        _write_arb(out, acb_realref(QQBAR_ENCLOSURE(CA_EXT_QQBAR(x))));
+        _write_arb(out, acb_imagref(QQBAR_ENCLOSURE(CA_EXT_QQBAR(x))));
+    }
+    else
+    {
+        /* the fields of the arguments must come first */
+        for (i = 0; i < CA_EXT_FUNC_NARGS(x); i++)
+        {
+            ca_srcptr arg = CA_EXT_FUNC_ARGS(x) + i;
+
+            if (CA_FIELD_UNSPECIAL(arg, ctx) != NULL)
+                _write_field(out, W, CA_FIELD_UNSPECIAL(arg, ctx), ctx);
+        }
+
+        calcium_write(out, "x f ");
+        calcium_write(out, calcium_func_name(CA_EXT_HEAD(x)));
+        calcium_write(out, " ");
+        calcium_write_si(out, CA_EXT_FUNC_NARGS(x));
+
+        for (i = 0; i < CA_EXT_FUNC_NARGS(x); i++)
+            _write_elem(out, W, CA_EXT_FUNC_ARGS(x) + i, ctx);
+
+        calcium_write(out, " ");
+        calcium_write_si(out, CA_EXT_FUNC_PREC(x));
+        _write_arb(out, acb_realref(CA_EXT_FUNC_ENCLOSURE(x)));
+        _write_arb(out, acb_imagref(CA_EXT_FUNC_ENCLOSURE(x)));
+    }
+
+    calcium_write(out, "\n");
+    entry->id = W->ext_next++;
+}
+
+static void
+_write_field(calcium_stream_t out, _ca_cache_writer_struct * W, ca_field_srcptr K, ca_ctx_t ctx)
+{
+    _ptr_id_struct * entry;
+    slong i;
+
+    entry = _ptr_id_find(W->field, W->field_len, K);
+
+    if (entry->id != -1)
+        return;
+
+    for (i = 0; i < CA_FIELD_LENGTH(K); i++)
+        _write_ext(out, W, CA_FIELD_EXT_ELEM(K, i), ctx);
+
+    calcium_write(out, "k ");
+    calcium_write_si(out, CA_FIELD_LENGTH(K));
+
+    for (i = 0; i < CA_FIELD_LENGTH(K); i++)
+    {
+        calcium_write(out, " ");
+        calcium_write_si(out, _ptr_id_find(W->ext, W->ext_len, CA_FIELD_EXT_ELEM(K, i))->id);
+    }
+
+    calcium_write(out, "\n");
+    entry->id = W->field_next++;
+}
+
+void
+ca_ctx_cache_write(calcium_stream_t out, ca_ctx_t ctx)
+{
+    _ca_cache_writer_struct W[1];
+    calcium_stream_t s;
+    ca_ctx_struct * c;
+    slong i, n;
+
+    ca_ctx_lock(ctx);
+
+    /* everything visible in ctx, including the caches of ancestors */
+    W->ext_len = W->field_len = 0;
+    for (c = ctx; c != NULL; c = c->parent)
+    {
+        W->ext_len += CA_CTX_EXT_CACHE(c)->length;
+        W->field_len += CA_CTX_FIELD_CACHE(c)->length;
+    }
+
+    W->ext = flint_malloc(sizeof(_ptr_id_struct) * FLINT_MAX(W->ext_len, 1));
+    W->field = flint_malloc(sizeof(_ptr_id_struct) * FLINT_MAX(W->field_len, 1));
+
+    n = 0;
+    for (c = ctx; c != NULL; c = c->parent)
+    {
+        for (i = 0; i < CA_CTX_EXT_CACHE(c)->length; i++)
+        {
+            W->ext[n].key = (ulong) CA_CTX_EXT_CACHE(c)->items[i];
+            W->ext[n].id = -1;
+            n++;
+        }
+    }
+
+    n = 0;
+    for (c = ctx; c != NULL; c = c->parent)
+    {
+        for (i = 0; i < CA_CTX_FIELD_CACHE(c)->length; i++)
+        {
+            W->field[n].key = (ulong) CA_CTX_FIELD_CACHE(c)->items[i];
+            W->field[n].id = -1;
+            n++;
+        }
+    }
+
+    qsort(W->ext, W->ext_len, sizeof(_ptr_id_struct), _ptr_id_cmp);
+    qsort(W->field, W->field_len, sizeof(_ptr_id_struct), _ptr_id_cmp);
+    W->ext_next = W->field_next = 0;
+
+    calcium_stream_init_str(s);
+
+    calcium_write(s, "calcium-cache ");
+    calcium_write_si(s, CA_CACHE_FORMAT_VERSION);
+    calcium_write(s, " ");
+    calcium_write(s, CALCIUM_VERSION);
+    calcium_write(s, " ");
+    calcium_write_si(s, ctx->options[CA_OPT_MPOLY_ORD]);
+    calcium_write(s, "\n");
+
+    /* fields pull in their generators, which pull in the fields
+       of their arguments; unused extension numbers are written last */
+    for (c = ctx; c != NULL; c = c->parent)
+        for (i = 0; i < CA_CTX_FIELD_CACHE(c)->length; i++)
+            _write_field(s, W, CA_CTX_FIELD_CACHE(c)->items[i], ctx);
+
+    for (c = ctx; c != NULL; c = c->parent)
+        for (i = 0; i < CA_CTX_EXT_CACHE(c)->length; i++)
+            _write_ext(s, W, CA_CTX_EXT_CACHE(c)->items[i], ctx);
+
+    ca_ctx_unlock(ctx);
+
+    calcium_write(out, s->s);
+    calcium_write(out, "end ");
+    _write_ui(out, _ca_ctx_cache_checksum(s->s, s->len));
+    calcium_write(out, "\n");
+
+    flint_free(s->s);
+    flint_free(W->ext);
+    flint_free(W->field);
+}
@@ -21,6 +21,11 @@ ca_ctx_clear(ca_ctx_t ctx)
     CA_INFO(ctx, ("%wd extension numbers cached at time of destruction\n", CA_CTX_EXT_CACHE(ctx)->length));
     CA_INFO(ctx, ("%wd fields cached at time of destruction\n", CA_CTX_FIELD_CACHE(ctx)->length));
 
+    _ca_ctx_clear_acb_cache(ctx);
+    _ca_ctx_clear_op_cache(ctx);
+    _ca_ctx_clear_merge_cache(ctx);
+    _ca_ctx_clear_primitive_cache(ctx);
+
     ca_ext_cache_clear(CA_CTX_EXT_CACHE(ctx), ctx);
     ca_field_cache_clear(CA_CTX_FIELD_CACHE(ctx), ctx);
 
@@ -28,6 +33,23 @@ ca_ctx_clear(ca_ctx_t ctx)
         flint_free(ctx->mctx[i]);
 
     flint_free(ctx->mctx);
+
+    for (i = 0; i < ctx->mctx_retired_len; i++)
+        flint_free(ctx->mctx_retired[i]);
+
+    flint_free(ctx->mctx_retired);
+
+    _ca_ctx_clear_transfer_tables(ctx);
+    _ca_ctx_clear_lock(ctx);
     flint_free(ctx->options);
+
+    if (ctx->parent != NULL)
+    {
+#if defined(__GNUC__)
+        __sync_sub_and_fetch(&ctx->parent->fork_count, 1);
+#else
+        ctx->parent->fork_count--;
+#endif
+    }
 }
 
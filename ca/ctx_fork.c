@@ -0,0 +1,72 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+void _ca_ctx_init_mctx(ca_ctx_t ctx, slong len);
+
+void
+ca_ctx_fork(ca_ctx_t ctx, ca_ctx_t parent)
+{
+    slong i;
+
+    ctx->options = flint_calloc(CA_OPT_NUM_OPTIONS, sizeof(slong));
+
+    for (i = 0; i < CA_OPT_NUM_OPTIONS; i++)
+        ctx->options[i] = parent->options[i];
+
+    ctx->mctx = NULL;
+    ctx->mctx_len = 0;
+    ctx->mctx_retired = NULL;
+    ctx->mctx_retired_len = 0;
+
+    ctx->cache_gen = 0;
+    ctx->cache_bytes = 0;
+    ctx->cache_depth = 0;
+    ctx->cache_sweep_countdown = 0;
+
+    ctx->parent = parent;
+    ctx->fork_depth = parent->fork_depth + 1;
+    ctx->fork_count = 0;
+
+    _ca_ctx_init_lock(ctx);
+    _ca_ctx_init_transfer_tables(ctx);
+    _ca_ctx_stats_zero(ctx);
+    ca_ctx_budget_start(ctx);
+
+    ctx->acb_cache = NULL;
+    ctx->acb_cache_size = 0;
+    ctx->op_cache = NULL;
+    ctx->op_cache_size = 0;
+    ctx->op_cache_options = NULL;
+    ctx->merge_cache = NULL;
+    ctx->merge_cache_size = 0;
+    ctx->primitive_cache = NULL;
+    ctx->primitive_cache_size = 0;
+
+    ca_ext_cache_init(CA_CTX_EXT_CACHE(ctx), ctx);
+    ca_field_cache_init(CA_CTX_FIELD_CACHE(ctx), ctx);
+
+    /* The parent fields use the multivariate context of whichever
+       context they are accessed through, so we need at least as many. */
+    _ca_ctx_init_mctx(ctx, parent->mctx_len);
+
+    ctx->field_qq = parent->field_qq;
+    ctx->field_qq_i = parent->field_qq_i;
+
+#if defined(__GNUC__)
+    __sync_add_and_fetch(&parent->fork_count, 1);
+#else
+    parent->fork_count++;
+#endif
+}
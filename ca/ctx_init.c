@@ -14,7 +14,7 @@
 #include "ca_field.h"
 
 void
-ca_ctx_init(ca_ctx_t ctx)
+ca_ctx_init_mpoly_ord(ca_ctx_t ctx, ordering_t ord)
 {
     qqbar_t onei;
     ca_ext_t ext;
@@ -34,11 +34,42 @@ ca_ctx_init(ca_ctx_t ctx)
     ctx->options[CA_OPT_GROEBNER_POLY_BITS_LIMIT] = 10000;
     ctx->options[CA_OPT_VIETA_LIMIT] = 6;
     ctx->options[CA_OPT_PRINT_FLAGS] = CA_PRINT_DEFAULT;
-    ctx->options[CA_OPT_MPOLY_ORD] = ORD_LEX;
+    ctx->options[CA_OPT_MPOLY_ORD] = ord;
     ctx->options[CA_OPT_TRIG_FORM] = CA_TRIG_EXPONENTIAL;
+    ctx->options[CA_OPT_ACB_CACHE_SIZE] = 256;
+    ctx->options[CA_OPT_REDUCTION_BATCH_LENGTH] = 200;
+    ctx->options[CA_OPT_MERGE_CACHE_SIZE] = 64;
+    ctx->options[CA_OPT_PRIMITIVE_DEG_LIMIT] = 0;
+    ctx->options[CA_OPT_PRIMITIVE_CACHE_SIZE] = 64;
 
     ctx->mctx = NULL;
     ctx->mctx_len = 0;
+    ctx->mctx_retired = NULL;
+    ctx->mctx_retired_len = 0;
+
+    ctx->cache_gen = 0;
+    ctx->cache_bytes = 0;
+    ctx->cache_depth = 0;
+    ctx->cache_sweep_countdown = 0;
+
+    ctx->parent = NULL;
+    ctx->fork_depth = 0;
+    ctx->fork_count = 0;
+
+    _ca_ctx_init_lock(ctx);
+    _ca_ctx_init_transfer_tables(ctx);
+    _ca_ctx_stats_zero(ctx);
+    ca_ctx_budget_start(ctx);
+
+    ctx->acb_cache = NULL;
+    ctx->acb_cache_size = 0;
+    ctx->op_cache = NULL;
+    ctx->op_cache_size = 0;
+    ctx->op_cache_options = NULL;
+    ctx->merge_cache = NULL;
+    ctx->merge_cache_size = 0;
+    ctx->primitive_cache = NULL;
+    ctx->primitive_cache_size = 0;
 
     ca_ext_cache_init(CA_CTX_EXT_CACHE(ctx), ctx);
     ca_field_cache_init(CA_CTX_FIELD_CACHE(ctx), ctx);
@@ -55,3 +86,9 @@ ca_ctx_init(ca_ctx_t ctx)
     qqbar_clear(onei);
     ca_ext_clear(ext, ctx);
 }
+
+void
+ca_ctx_init(ca_ctx_t ctx)
+{
+    ca_ctx_init_mpoly_ord(ctx, ORD_LEX);
+}
@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+/* needed for PTHREAD_MUTEX_RECURSIVE with -ansi */
+#define _XOPEN_SOURCE 700
+
+#include "ca.h"
+
+void
+_ca_ctx_init_lock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutexattr_t attr;
+
+    /* building a field can recursively build other fields */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&ctx->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+#endif
+}
+
+void
+_ca_ctx_clear_lock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&ctx->mutex);
+#endif
+}
+
+void
+ca_ctx_lock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    if (ctx->options[CA_OPT_THREAD_SAFE])
+        pthread_mutex_lock(&ctx->mutex);
+#endif
+}
+
+void
+ca_ctx_unlock(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    if (ctx->options[CA_OPT_THREAD_SAFE])
+        pthread_mutex_unlock(&ctx->mutex);
+#endif
+}
+
+/* Forks read the caches of their ancestors, possibly from other threads,
+   so a context with live forks guards its caches with the lock even
+   when it is not itself in thread-safe mode. Returns whether the lock
+   was taken; this must be passed to _ca_ctx_unlock_shared, since a fork
+   may be created or cleared in the meantime. */
+int
+_ca_ctx_lock_shared(ca_ctx_t ctx)
+{
+#if FLINT_USES_PTHREAD
+    if (ctx->options[CA_OPT_THREAD_SAFE] || ctx->fork_count != 0)
+    {
+        pthread_mutex_lock(&ctx->mutex);
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+void
+_ca_ctx_unlock_shared(ca_ctx_t ctx, int locked)
+{
+#if FLINT_USES_PTHREAD
+    if (locked)
+        pthread_mutex_unlock(&ctx->mutex);
+#endif
+}
@@ -0,0 +1,157 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+/* The memo is a direct-mapped table indexed by a symmetric hash of
+   the two field pointers. Entries do not hold references to their
+   fields; instead, the table is emptied by cache sweeps, which are
+   the only place where fields are evicted. */
+
+void
+_ca_ctx_clear_merge_cache(ca_ctx_t ctx)
+{
+    slong i;
+
+    ca_ctx_lock(ctx);
+
+    for (i = 0; i < ctx->merge_cache_size; i++)
+    {
+        flint_free(ctx->merge_cache[i].xgen_map);
+        flint_free(ctx->merge_cache[i].ygen_map);
+    }
+
+    flint_free(ctx->merge_cache);
+    ctx->merge_cache = NULL;
+    ctx->merge_cache_size = 0;
+
+    ca_ctx_unlock(ctx);
+}
+
+static void
+_slong_vec_copy(slong * res, const slong * x, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        res[i] = x[i];
+}
+
+/* Returns the slot for the pair (x, y), (re)allocating the table if
+   the size option has changed, or NULL if the memo is disabled.
+   The caller must hold the lock. */
+static ca_merge_cache_entry_struct *
+_ca_ctx_merge_cache_slot(ca_field_srcptr x, ca_field_srcptr y, ca_ctx_t ctx)
+{
+    slong i, size;
+    ulong hash;
+
+    if (ctx->options[CA_OPT_MERGE_CACHE_SIZE] <= 0)
+        return NULL;
+
+    size = 1;
+    while (size < ctx->options[CA_OPT_MERGE_CACHE_SIZE])
+        size *= 2;
+
+    if (size != ctx->merge_cache_size)
+    {
+        _ca_ctx_clear_merge_cache(ctx);
+
+        ctx->merge_cache = flint_malloc(sizeof(ca_merge_cache_entry_struct) * size);
+
+        for (i = 0; i < size; i++)
+        {
+            ctx->merge_cache[i].x = NULL;
+            ctx->merge_cache[i].y = NULL;
+            ctx->merge_cache[i].field = NULL;
+            ctx->merge_cache[i].xgen_map = NULL;
+            ctx->merge_cache[i].ygen_map = NULL;
+        }
+
+        ctx->merge_cache_size = size;
+    }
+
+    hash = (((ulong) x) >> 4) + (((ulong) y) >> 4);
+    hash ^= hash >> 11;
+
+    return ctx->merge_cache + (hash & (size - 1));
+}
+
+ca_field_srcptr
+_ca_ctx_merge_cache_lookup(slong * xgen_map, slong * ygen_map,
+    ca_field_srcptr x, ca_field_srcptr y, ca_ctx_t ctx)
+{
+    ca_merge_cache_entry_struct * entry;
+    ca_field_srcptr field;
+
+    field = NULL;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_merge_cache_slot(x, y, ctx);
+
+    if (entry != NULL)
+    {
+        if (entry->x == x && entry->y == y)
+        {
+            field = entry->field;
+            _slong_vec_copy(xgen_map, entry->xgen_map, CA_FIELD_LENGTH(x));
+            _slong_vec_copy(ygen_map, entry->ygen_map, CA_FIELD_LENGTH(y));
+        }
+        else if (entry->x == y && entry->y == x)
+        {
+            field = entry->field;
+            _slong_vec_copy(xgen_map, entry->ygen_map, CA_FIELD_LENGTH(x));
+            _slong_vec_copy(ygen_map, entry->xgen_map, CA_FIELD_LENGTH(y));
+        }
+
+        /* let the field cache complete the ideal */
+        if (field != NULL && (field->ideal_flags & CA_FIELD_IDEAL_INCOMPLETE))
+            field = NULL;
+
+        if (field != NULL)
+            CA_CTX_STATS_ADD(ctx, merge_cache_hits, 1);
+        else
+            CA_CTX_STATS_ADD(ctx, merge_cache_misses, 1);
+    }
+
+    ca_ctx_unlock(ctx);
+
+    return field;
+}
+
+void
+_ca_ctx_merge_cache_insert(ca_field_srcptr x, ca_field_srcptr y, ca_field_srcptr field,
+    const slong * xgen_map, const slong * ygen_map, ca_ctx_t ctx)
+{
+    ca_merge_cache_entry_struct * entry;
+    slong xlen, ylen;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_merge_cache_slot(x, y, ctx);
+
+    if (entry != NULL)
+    {
+        xlen = CA_FIELD_LENGTH(x);
+        ylen = CA_FIELD_LENGTH(y);
+
+        entry->x = x;
+        entry->y = y;
+        entry->field = field;
+        entry->xgen_map = flint_realloc(entry->xgen_map, sizeof(slong) * xlen);
+        entry->ygen_map = flint_realloc(entry->ygen_map, sizeof(slong) * ylen);
+        _slong_vec_copy(entry->xgen_map, xgen_map, xlen);
+        _slong_vec_copy(entry->ygen_map, ygen_map, ylen);
+    }
+
+    ca_ctx_unlock(ctx);
+}
@@ -0,0 +1,212 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+/* Direct-mapped memo of operation results, organized like the
+   enclosure memo (see ctx_acb_cache.c). Entries hold references to
+   their fields and are discarded by cache sweeps. Results depend on
+   the evaluation options, which are not part of the key; instead,
+   the table keeps a copy of the options it was filled with and is
+   flushed when they change. */
+
+void
+_ca_ctx_clear_op_cache(ca_ctx_t ctx)
+{
+    slong i;
+
+    ca_ctx_lock(ctx);
+
+    for (i = 0; i < ctx->op_cache_size; i++)
+    {
+        ca_clear(&ctx->op_cache[i].x, ctx);
+        ca_clear(&ctx->op_cache[i].y, ctx);
+        ca_clear(&ctx->op_cache[i].res, ctx);
+    }
+
+    flint_free(ctx->op_cache);
+    flint_free(ctx->op_cache_options);
+    ctx->op_cache = NULL;
+    ctx->op_cache_size = 0;
+    ctx->op_cache_options = NULL;
+
+    ca_ctx_unlock(ctx);
+}
+
+/* Whether the options have changed since the table was filled.
+   Printing and the budget do not affect stored results (results
+   computed after the budget has run out are never stored). */
+static int
+_ca_ctx_op_cache_options_changed(ca_ctx_t ctx)
+{
+    slong i;
+
+    if (ctx->op_cache_options == NULL)
+        return 1;
+
+    for (i = 0; i < CA_OPT_NUM_OPTIONS; i++)
+    {
+        if (i == CA_OPT_VERBOSE || i == CA_OPT_PRINT_FLAGS ||
+            i == CA_OPT_WORK_LIMIT || i == CA_OPT_TIME_LIMIT)
+            continue;
+
+        if (ctx->op_cache_options[i] != ctx->options[i])
+            return 1;
+    }
+
+    return 0;
+}
+
+/* The caller must hold the lock. */
+static ca_op_cache_entry_struct *
+_ca_ctx_op_cache_slot(ulong hash, ca_ctx_t ctx)
+{
+    slong i, size;
+
+    size = 1;
+    while (size < ctx->options[CA_OPT_OP_CACHE_SIZE])
+        size *= 2;
+
+    if (size != ctx->op_cache_size || _ca_ctx_op_cache_options_changed(ctx))
+    {
+        _ca_ctx_clear_op_cache(ctx);
+
+        ctx->op_cache = flint_malloc(sizeof(ca_op_cache_entry_struct) * size);
+
+        for (i = 0; i < size; i++)
+        {
+            ctx->op_cache[i].hash = 0;
+            ctx->op_cache[i].op = -1;
+            ca_init(&ctx->op_cache[i].x, ctx);
+            ca_init(&ctx->op_cache[i].y, ctx);
+            ca_init(&ctx->op_cache[i].res, ctx);
+        }
+
+        ctx->op_cache_size = size;
+
+        ctx->op_cache_options = flint_malloc(sizeof(slong) * CA_OPT_NUM_OPTIONS);
+        for (i = 0; i < CA_OPT_NUM_OPTIONS; i++)
+            ctx->op_cache_options[i] = ctx->options[i];
+    }
+
+    return ctx->op_cache + (hash & (size - 1));
+}
+
+static int
+_ca_op_cache_lookup(ca_t res, ulong hash, calcium_func_code op, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    ca_op_cache_entry_struct * entry;
+    int found;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_op_cache_slot(hash, ctx);
+
+    found = (entry->op == op && entry->hash == hash &&
+        ca_equal_repr(&entry->x, x, ctx) &&
+        (y == NULL || ca_equal_repr(&entry->y, y, ctx)));
+
+    if (found)
+    {
+        ca_set(res, &entry->res, ctx);
+        CA_CTX_STATS_ADD(ctx, op_cache_hits, 1);
+    }
+    else
+    {
+        CA_CTX_STATS_ADD(ctx, op_cache_misses, 1);
+    }
+
+    ca_ctx_unlock(ctx);
+
+    return found;
+}
+
+static void
+_ca_op_cache_insert(ulong hash, calcium_func_code op, const ca_t x, const ca_t y, const ca_t res, ca_ctx_t ctx)
+{
+    ca_op_cache_entry_struct * entry;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_op_cache_slot(hash, ctx);
+
+    entry->hash = hash;
+    entry->op = op;
+    ca_set(&entry->x, x, ctx);
+    if (y == NULL)
+        ca_zero(&entry->y, ctx);
+    else
+        ca_set(&entry->y, y, ctx);
+    ca_set(&entry->res, res, ctx);
+
+    ca_ctx_unlock(ctx);
+}
+
+void
+_ca_op_cached_unary(ca_t res, const ca_t x, calcium_func_code op,
+    void (*func)(ca_t, const ca_t, ca_ctx_t), ca_ctx_t ctx)
+{
+    ulong hash;
+    ca_t t;
+
+    /* Results inside a reduction batch may be unreduced. */
+    if (ctx->options[CA_OPT_OP_CACHE_SIZE] <= 0 || _ca_ctx_reduction_batch_depth(ctx) != 0 || CA_IS_SPECIAL(x))
+    {
+        func(res, x, ctx);
+        return;
+    }
+
+    hash = ca_hash_repr(x, ctx) * 1000003 + op;
+
+    if (_ca_op_cache_lookup(res, hash, op, x, NULL, ctx))
+        return;
+
+    ca_init(t, ctx);
+    func(t, x, ctx);
+
+    /* results degraded by an exhausted budget are not kept */
+    if (!ca_ctx_budget_exceeded(ctx))
+        _ca_op_cache_insert(hash, op, x, NULL, t, ctx);
+    ca_swap(res, t, ctx);
+    ca_clear(t, ctx);
+}
+
+void
+_ca_op_cached_binary(ca_t res, const ca_t x, const ca_t y, calcium_func_code op,
+    void (*func)(ca_t, const ca_t, const ca_t, ca_ctx_t), ca_ctx_t ctx)
+{
+    ulong hash;
+    ca_t t;
+
+    /* Arithmetic outside multivariate fields is cheap enough
+       that hashing the operands would not pay off. Results inside
+       a reduction batch may be unreduced. */
+    if (ctx->options[CA_OPT_OP_CACHE_SIZE] <= 0 || _ca_ctx_reduction_batch_depth(ctx) != 0 ||
+        CA_IS_SPECIAL(x) || CA_IS_SPECIAL(y) ||
+        (!CA_FIELD_IS_GENERIC(CA_FIELD(x, ctx)) && !CA_FIELD_IS_GENERIC(CA_FIELD(y, ctx))))
+    {
+        func(res, x, y, ctx);
+        return;
+    }
+
+    hash = (ca_hash_repr(x, ctx) * 1000003 + ca_hash_repr(y, ctx)) * 1000003 + op;
+
+    if (_ca_op_cache_lookup(res, hash, op, x, y, ctx))
+        return;
+
+    ca_init(t, ctx);
+    func(t, x, y, ctx);
+
+    if (!ca_ctx_budget_exceeded(ctx))
+        _ca_op_cache_insert(hash, op, x, y, t, ctx);
+    ca_swap(res, t, ctx);
+    ca_clear(t, ctx);
+}
@@ -0,0 +1,169 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_field.h"
+
+ca_field_ptr ca_ctx_get_field_qqbar(ca_ctx_t ctx, const qqbar_t x);
+
+/* The memo is a direct-mapped table indexed by the field pointer, sized
+   by CA_OPT_PRIMITIVE_CACHE_SIZE. As for the merge memo, entries do not hold
+   references to their fields and the table is emptied by cache sweeps. */
+
+static void
+_ca_primitive_cache_entry_clear(ca_primitive_cache_entry_struct * entry)
+{
+    slong i;
+
+    if (entry->field != NULL && entry->nf != NULL)
+    {
+        for (i = 0; i < CA_FIELD_LENGTH(entry->field); i++)
+            fmpq_poly_clear(entry->images + i);
+
+        flint_free(entry->images);
+    }
+
+    entry->field = NULL;
+    entry->nf = NULL;
+    entry->images = NULL;
+}
+
+void
+_ca_ctx_clear_primitive_cache(ca_ctx_t ctx)
+{
+    slong i;
+
+    ca_ctx_lock(ctx);
+
+    for (i = 0; i < ctx->primitive_cache_size; i++)
+        _ca_primitive_cache_entry_clear(ctx->primitive_cache + i);
+
+    flint_free(ctx->primitive_cache);
+    ctx->primitive_cache = NULL;
+    ctx->primitive_cache_size = 0;
+
+    ca_ctx_unlock(ctx);
+}
+
+/* Returns the slot for field, (re)allocating the table if the size
+   option has changed, or NULL if the memo is disabled.
+   The caller must hold the lock. */
+static ca_primitive_cache_entry_struct *
+_ca_ctx_primitive_cache_slot(ca_field_srcptr field, ca_ctx_t ctx)
+{
+    slong i, size;
+    ulong hash;
+
+    if (ctx->options[CA_OPT_PRIMITIVE_CACHE_SIZE] <= 0)
+        return NULL;
+
+    size = 1;
+    while (size < ctx->options[CA_OPT_PRIMITIVE_CACHE_SIZE])
+        size *= 2;
+
+    if (size != ctx->primitive_cache_size)
+    {
+        _ca_ctx_clear_primitive_cache(ctx);
+
+        ctx->primitive_cache = flint_malloc(sizeof(ca_primitive_cache_entry_struct) * size);
+
+        for (i = 0; i < size; i++)
+        {
+            ctx->primitive_cache[i].field = NULL;
+            ctx->primitive_cache[i].nf = NULL;
+            ctx->primitive_cache[i].images = NULL;
+        }
+
+        ctx->primitive_cache_size = size;
+    }
+
+    hash = ((ulong) field) >> 4;
+    hash ^= hash >> 11;
+
+    return ctx->primitive_cache + (hash & (size - 1));
+}
+
+ca_field_srcptr
+_ca_ctx_get_field_primitive(fmpq_poly_struct * images, ca_field_srcptr field, ca_ctx_t ctx)
+{
+    ca_primitive_cache_entry_struct * entry;
+    ca_field_srcptr nf;
+    qqbar_t theta;
+    slong i, len;
+    int found;
+
+    len = CA_FIELD_LENGTH(field);
+    found = 0;
+    nf = NULL;
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_primitive_cache_slot(field, ctx);
+
+    if (entry != NULL)
+    {
+        if (entry->field == field)
+        {
+            found = 1;
+            nf = entry->nf;
+
+            if (nf != NULL)
+                for (i = 0; i < len; i++)
+                    fmpq_poly_set(images + i, entry->images + i);
+
+            CA_CTX_STATS_ADD(ctx, primitive_cache_hits, 1);
+        }
+        else
+        {
+            CA_CTX_STATS_ADD(ctx, primitive_cache_misses, 1);
+        }
+    }
+
+    ca_ctx_unlock(ctx);
+
+    if (found)
+        return nf;
+
+    /* The qqbar arithmetic is done without holding the lock. */
+    qqbar_init(theta);
+
+    if (ca_field_primitive_element(theta, images, field, ctx->options[CA_OPT_PRIMITIVE_DEG_LIMIT], ctx))
+        nf = ca_ctx_get_field_qqbar(ctx, theta);
+
+    qqbar_clear(theta);
+
+    ca_ctx_lock(ctx);
+
+    entry = _ca_ctx_primitive_cache_slot(field, ctx);
+
+    if (entry != NULL)
+    {
+        _ca_primitive_cache_entry_clear(entry);
+
+        entry->field = field;
+        entry->nf = nf;
+
+        if (nf != NULL)
+        {
+            entry->images = flint_malloc(sizeof(fmpq_poly_struct) * len);
+
+            for (i = 0; i < len; i++)
+            {
+                fmpq_poly_init(entry->images + i);
+                fmpq_poly_set(entry->images + i, images + i);
+            }
+        }
+    }
+
+    ca_ctx_unlock(ctx);
+
+    return nf;
+}
@@ -18,6 +18,8 @@ ca_ctx_print(ca_ctx_t ctx)
 {
     slong i;
 
+    ca_ctx_lock(ctx);
+
     flint_printf("Calcium context with %wd cached fields:\n", CA_CTX_FIELD_CACHE(ctx)->length);
     for (i = 0; i < CA_CTX_FIELD_CACHE(ctx)->length; i++)
     {
@@ -26,5 +28,7 @@ ca_ctx_print(ca_ctx_t ctx)
         flint_printf("\n");
     }
     flint_printf("\n");
+
+    ca_ctx_unlock(ctx);
 }
 
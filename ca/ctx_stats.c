@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+void
+_ca_ctx_stats_zero(ca_ctx_t ctx)
+{
+    ca_ctx_stats_struct * s = &ctx->stats;
+
+    s->ext_cache_hits = 0;
+    s->ext_cache_misses = 0;
+    s->field_cache_hits = 0;
+    s->field_cache_misses = 0;
+    s->ideal_length = 0;
+    s->ideal_max_length = 0;
+    s->groebner_runs = 0;
+    s->groebner_reductions = 0;
+    s->lll_calls = 0;
+    s->lll_skipped = 0;
+    s->ideal_seeded = 0;
+    s->is_zero_numerical = 0;
+    s->is_zero_prec_steps = 0;
+    s->acb_cache_hits = 0;
+    s->acb_cache_misses = 0;
+    s->op_cache_hits = 0;
+    s->op_cache_misses = 0;
+    s->merge_cache_hits = 0;
+    s->merge_cache_misses = 0;
+    s->primitive_cache_hits = 0;
+    s->primitive_cache_misses = 0;
+    s->qqbar.composed_ops = 0;
+    s->qqbar.composed_degree = 0;
+    s->qqbar.composed_max_degree = 0;
+    s->qqbar.factor_time = 0.0;
+    s->qqbar.composed_cache_hits = 0;
+    s->qqbar.composed_cache_misses = 0;
+}
+
+void
+ca_ctx_stats_get(ca_ctx_stats_t stats, ca_ctx_t ctx)
+{
+    ca_ctx_lock(ctx);
+    *stats = ctx->stats;
+    ca_ctx_unlock(ctx);
+
+    qqbar_stats_get(&stats->qqbar);
+}
+
+void
+ca_ctx_stats_reset(ca_ctx_t ctx)
+{
+    ca_ctx_lock(ctx);
+    _ca_ctx_stats_zero(ctx);
+    ca_ctx_unlock(ctx);
+
+    qqbar_stats_reset();
+}
+
+void
+ca_ctx_stats_print(ca_ctx_t ctx)
+{
+    ca_ctx_stats_t s;
+
+    ca_ctx_stats_get(s, ctx);
+
+    flint_printf("Extension cache:     %wd hits, %wd misses\n", s->ext_cache_hits, s->ext_cache_misses);
+    flint_printf("Field cache:         %wd hits, %wd misses\n", s->field_cache_hits, s->field_cache_misses);
+    flint_printf("Reduction ideals:    %wd polynomials, longest %wd\n", s->ideal_length, s->ideal_max_length);
+    flint_printf("Groebner bases:      %wd runs, %wd S-polynomial reductions\n", s->groebner_runs, s->groebner_reductions);
+    flint_printf("Relation searches:   %wd, %wd skipped\n", s->lll_calls, s->lll_skipped);
+    flint_printf("Seeded ideals:       %wd\n", s->ideal_seeded);
+    flint_printf("Numerical zero tests: %wd, %wd precision steps\n", s->is_zero_numerical, s->is_zero_prec_steps);
+    flint_printf("Memoized enclosures: %wd hits, %wd misses\n", s->acb_cache_hits, s->acb_cache_misses);
+    flint_printf("Memoized operations: %wd hits, %wd misses\n", s->op_cache_hits, s->op_cache_misses);
+    flint_printf("Memoized merges:     %wd hits, %wd misses\n", s->merge_cache_hits, s->merge_cache_misses);
+    flint_printf("Primitive elements:  %wd hits, %wd misses\n", s->primitive_cache_hits, s->primitive_cache_misses);
+    flint_printf("qqbar composed ops:  %wd, total degree %wd, max degree %wd, factoring %.3f s\n",
+        s->qqbar.composed_ops, s->qqbar.composed_degree, s->qqbar.composed_max_degree, s->qqbar.factor_time);
+    flint_printf("qqbar factorizations: %wd memo hits, %wd misses\n", s->qqbar.composed_cache_hits, s->qqbar.composed_cache_misses);
+}
@@ -0,0 +1,171 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+static ulong _ca_ctx_serial_counter = 0;
+
+static ulong
+_ca_ctx_new_serial(void)
+{
+#if defined(__GNUC__)
+    return __sync_add_and_fetch(&_ca_ctx_serial_counter, 1);
+#else
+    return ++_ca_ctx_serial_counter;
+#endif
+}
+
+static void
+_ca_transfer_table_reset(ca_transfer_table_struct * T)
+{
+    flint_free(T->keys);
+    flint_free(T->values);
+    T->src_serial = 0;
+    T->src_gen = T->gen = 0;
+    T->length = T->alloc = 0;
+    T->keys = NULL;
+    T->values = NULL;
+}
+
+void
+_ca_ctx_init_transfer_tables(ca_ctx_t ctx)
+{
+    slong i;
+
+    ctx->serial = _ca_ctx_new_serial();
+
+    for (i = 0; i < CA_CTX_TRANSFER_TABLES; i++)
+    {
+        ctx->transfer_table[i].keys = NULL;
+        ctx->transfer_table[i].values = NULL;
+        _ca_transfer_table_reset(ctx->transfer_table + i);
+    }
+
+    ctx->transfer_table_next = 0;
+}
+
+void
+_ca_ctx_clear_transfer_tables(ca_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < CA_CTX_TRANSFER_TABLES; i++)
+        _ca_transfer_table_reset(ctx->transfer_table + i);
+}
+
+/* Detaches all tables of ctx from their source contexts, so that they
+   are emptied before they are used again. Tables handed out earlier
+   remain valid memory. */
+void
+_ca_ctx_invalidate_transfer_tables(ca_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < CA_CTX_TRANSFER_TABLES; i++)
+        ctx->transfer_table[i].src_serial = 0;
+}
+
+/* Returns the table for transfers from src_ctx, emptying it if any objects
+   may have been evicted from either context since it was filled.
+   The caller must hold the lock of ctx. */
+ca_transfer_table_struct *
+_ca_ctx_transfer_table(ca_ctx_t ctx, ca_ctx_t src_ctx)
+{
+    ca_transfer_table_struct * T;
+    slong i;
+
+    T = NULL;
+    for (i = 0; i < CA_CTX_TRANSFER_TABLES; i++)
+        if (ctx->transfer_table[i].src_serial == src_ctx->serial)
+            T = ctx->transfer_table + i;
+
+    if (T == NULL)
+    {
+        T = ctx->transfer_table + ctx->transfer_table_next;
+        ctx->transfer_table_next = (ctx->transfer_table_next + 1) % CA_CTX_TRANSFER_TABLES;
+        _ca_transfer_table_reset(T);
+    }
+    else if (T->src_gen != src_ctx->cache_gen || T->gen != ctx->cache_gen)
+    {
+        _ca_transfer_table_reset(T);
+    }
+
+    T->src_serial = src_ctx->serial;
+    T->src_gen = src_ctx->cache_gen;
+    T->gen = ctx->cache_gen;
+
+    return T;
+}
+
+#define HASH_PTR(key, alloc) ((((key) >> 4) * UWORD(2654435761)) & ((alloc) - 1))
+
+ulong
+_ca_transfer_table_get(const ca_transfer_table_struct * T, const void * key)
+{
+    ulong k, i;
+
+    if (T->length == 0)
+        return 0;
+
+    k = (ulong) key;
+
+    for (i = HASH_PTR(k, T->alloc); T->keys[i] != 0; i = (i + 1) & (T->alloc - 1))
+        if (T->keys[i] == k)
+            return T->values[i];
+
+    return 0;
+}
+
+void
+_ca_transfer_table_set(ca_transfer_table_struct * T, const void * key, ulong value)
+{
+    ulong k, i;
+
+    /* keep the load factor below 1/2 */
+    if (2 * (T->length + 1) > T->alloc)
+    {
+        ulong * keys = T->keys;
+        ulong * values = T->values;
+        slong j, alloc = T->alloc;
+
+        T->alloc = FLINT_MAX(16, 2 * alloc);
+        T->keys = flint_calloc(T->alloc, sizeof(ulong));
+        T->values = flint_malloc(T->alloc * sizeof(ulong));
+
+        for (j = 0; j < alloc; j++)
+        {
+            if (keys[j] != 0)
+            {
+                for (i = HASH_PTR(keys[j], T->alloc); T->keys[i] != 0; i = (i + 1) & (T->alloc - 1)) ;
+                T->keys[i] = keys[j];
+                T->values[i] = values[j];
+            }
+        }
+
+        flint_free(keys);
+        flint_free(values);
+    }
+
+    k = (ulong) key;
+
+    for (i = HASH_PTR(k, T->alloc); T->keys[i] != 0; i = (i + 1) & (T->alloc - 1))
+    {
+        if (T->keys[i] == k)
+        {
+            T->values[i] = value;
+            return;
+        }
+    }
+
+    T->keys[i] = k;
+    T->values[i] = value;
+    T->length++;
+}
@@ -137,8 +137,8 @@ ca_ui_div(ca_t res, ulong x, const ca_t y, ca_ctx_t ctx)
     ca_clear(t, ctx);
 }
 
-void
-ca_div(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+static void
+_ca_div_uncached(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     ca_field_srcptr xfield, yfield, zfield;
     truth_t x_is_zero, y_is_zero;
@@ -238,3 +238,9 @@ ca_div(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
         ca_clear(t, ctx);
     }
 }
+
+void
+ca_div(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    _ca_op_cached_binary(res, x, y, CA_Div, _ca_div_uncached, ctx);
+}
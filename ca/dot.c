@@ -11,10 +11,198 @@
 
 #include "ca.h"
 
+/* Returns QQ if all terms are rational, the number field K if all
+   terms belong to QQ or K, and NULL otherwise. */
+static ca_field_srcptr
+_ca_dot_common_field(const ca_t initial, ca_srcptr x, slong xstep,
+    ca_srcptr y, slong ystep, slong len, ca_ctx_t ctx)
+{
+    ca_field_srcptr K, L;
+    slong i, j;
+    ca_srcptr v;
+
+    K = ctx->field_qq;
+
+    for (i = -1; i < len; i++)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            if (i == -1)
+            {
+                if (initial == NULL || j == 1)
+                    continue;
+                v = initial;
+            }
+            else
+            {
+                v = (j == 0) ? x + i * xstep : y + i * ystep;
+            }
+
+            if (CA_IS_SPECIAL(v))
+                return NULL;
+
+            L = CA_FIELD(v, ctx);
+
+            if (L == K || CA_FIELD_IS_QQ(L))
+                continue;
+
+            if (!CA_FIELD_IS_QQ(K) || CA_FIELD_IS_GENERIC(L))
+                return NULL;
+
+            K = L;
+        }
+    }
+
+    return K;
+}
+
+/* All terms are rational: sum the numerators over the least
+   common denominator and canonicalise once. */
+static void
+_ca_dot_fmpq(ca_t res, const ca_t initial, int subtract,
+    ca_srcptr x, slong xstep, ca_srcptr y, slong ystep, slong len, ca_ctx_t ctx)
+{
+    fmpz_t num, den, t, u;
+    ca_srcptr a, b;
+    slong i;
+
+    fmpz_init(num);
+    fmpz_init(den);
+    fmpz_init(t);
+    fmpz_init(u);
+
+    fmpz_one(den);
+
+    for (i = 0; i < len; i++)
+    {
+        a = x + i * xstep;
+        b = y + i * ystep;
+
+        if (!fmpz_is_one(CA_FMPQ_DENREF(a)) || !fmpz_is_one(CA_FMPQ_DENREF(b)))
+        {
+            fmpz_mul(t, CA_FMPQ_DENREF(a), CA_FMPQ_DENREF(b));
+            fmpz_lcm(den, den, t);
+        }
+    }
+
+    if (initial != NULL)
+        fmpz_lcm(den, den, CA_FMPQ_DENREF(initial));
+
+    for (i = 0; i < len; i++)
+    {
+        a = x + i * xstep;
+        b = y + i * ystep;
+
+        if (fmpz_is_one(den))
+        {
+            fmpz_addmul(num, CA_FMPQ_NUMREF(a), CA_FMPQ_NUMREF(b));
+        }
+        else
+        {
+            fmpz_mul(t, CA_FMPQ_DENREF(a), CA_FMPQ_DENREF(b));
+            fmpz_divexact(t, den, t);
+            fmpz_mul(u, CA_FMPQ_NUMREF(a), CA_FMPQ_NUMREF(b));
+            fmpz_addmul(num, u, t);
+        }
+    }
+
+    if (subtract)
+        fmpz_neg(num, num);
+
+    if (initial != NULL)
+    {
+        fmpz_divexact(t, den, CA_FMPQ_DENREF(initial));
+        fmpz_addmul(num, CA_FMPQ_NUMREF(initial), t);
+    }
+
+    _ca_make_fmpq(res, ctx);
+    fmpz_swap(CA_FMPQ_NUMREF(res), num);
+    fmpz_swap(CA_FMPQ_DENREF(res), den);
+    fmpq_canonicalise(CA_FMPQ(res));
+
+    fmpz_clear(num);
+    fmpz_clear(den);
+    fmpz_clear(t);
+    fmpz_clear(u);
+}
+
+static void
+_ca_get_fmpq_poly_nf(fmpq_poly_t res, const ca_t x, const nf_t nf, ca_ctx_t ctx)
+{
+    if (CA_IS_QQ(x, ctx))
+        fmpq_poly_set_fmpq(res, CA_FMPQ(x));
+    else
+        nf_elem_get_fmpq_poly(res, CA_NF_ELEM(x), nf);
+}
+
+/* All terms belong to the number field K: accumulate unreduced
+   polynomial products and reduce by the defining polynomial once. */
+static void
+_ca_dot_nf(ca_t res, const ca_t initial, int subtract,
+    ca_srcptr x, slong xstep, ca_srcptr y, slong ystep, slong len,
+    ca_field_srcptr K, ca_ctx_t ctx)
+{
+    const nf_struct * nf;
+    fmpq_poly_t s, a, b;
+    ca_srcptr u, v;
+    slong i;
+
+    nf = CA_FIELD_NF(K);
+
+    fmpq_poly_init(s);
+    fmpq_poly_init(a);
+    fmpq_poly_init(b);
+
+    for (i = 0; i < len; i++)
+    {
+        u = x + i * xstep;
+        v = y + i * ystep;
+
+        if (CA_IS_QQ(u, ctx))
+        {
+            _ca_get_fmpq_poly_nf(a, v, nf, ctx);
+            fmpq_poly_scalar_mul_fmpq(a, a, CA_FMPQ(u));
+        }
+        else if (CA_IS_QQ(v, ctx))
+        {
+            _ca_get_fmpq_poly_nf(a, u, nf, ctx);
+            fmpq_poly_scalar_mul_fmpq(a, a, CA_FMPQ(v));
+        }
+        else
+        {
+            _ca_get_fmpq_poly_nf(a, u, nf, ctx);
+            _ca_get_fmpq_poly_nf(b, v, nf, ctx);
+            fmpq_poly_mul(a, a, b);
+        }
+
+        fmpq_poly_add(s, s, a);
+    }
+
+    if (subtract)
+        fmpq_poly_neg(s, s);
+
+    if (initial != NULL)
+    {
+        _ca_get_fmpq_poly_nf(a, initial, nf, ctx);
+        fmpq_poly_add(s, s, a);
+    }
+
+    fmpq_poly_rem(s, s, nf->pol);
+
+    _ca_make_field_element(res, K, ctx);
+    nf_elem_set_fmpq_poly(CA_NF_ELEM(res), s, nf);
+    ca_condense_field(res, ctx);
+
+    fmpq_poly_clear(s);
+    fmpq_poly_clear(a);
+    fmpq_poly_clear(b);
+}
+
 void
 ca_dot(ca_t res, const ca_t initial, int subtract,
     ca_srcptr x, slong xstep, ca_srcptr y, slong ystep, slong len, ca_ctx_t ctx)
 {
+    ca_field_srcptr K;
     slong i;
     ca_t t;
 
@@ -27,8 +215,22 @@ ca_dot(ca_t res, const ca_t initial, int subtract,
         return;
     }
 
+    K = _ca_dot_common_field(initial, x, xstep, y, ystep, len, ctx);
+
+    if (K != NULL)
+    {
+        if (CA_FIELD_IS_QQ(K))
+            _ca_dot_fmpq(res, initial, subtract, x, xstep, y, ystep, len, ctx);
+        else
+            _ca_dot_nf(res, initial, subtract, x, xstep, y, ystep, len, K, ctx);
+        return;
+    }
+
     ca_init(t, ctx);
 
+    /* only reduce the final sum by the ideal */
+    ca_ctx_begin_reduction_batch(ctx);
+
     if (initial == NULL)
     {
         ca_mul(res, x, y, ctx);
@@ -53,5 +255,42 @@ ca_dot(ca_t res, const ca_t initial, int subtract,
     if (subtract)
         ca_neg(res, res, ctx);
 
+    ca_reduce(res, ctx);
+    ca_ctx_end_reduction_batch(ctx);
+
     ca_clear(t, ctx);
 }
+
+void
+ca_addmul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    if (res == x || res == y)
+    {
+        ca_t t;
+        ca_init(t, ctx);
+        ca_mul(t, x, y, ctx);
+        ca_add(res, res, t, ctx);
+        ca_clear(t, ctx);
+    }
+    else
+    {
+        ca_dot(res, res, 0, x, 1, y, 1, 1, ctx);
+    }
+}
+
+void
+ca_submul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    if (res == x || res == y)
+    {
+        ca_t t;
+        ca_init(t, ctx);
+        ca_mul(t, x, y, ctx);
+        ca_sub(res, res, t, ctx);
+        ca_clear(t, ctx);
+    }
+    else
+    {
+        ca_dot(res, res, 1, x, 1, y, 1, 1, ctx);
+    }
+}
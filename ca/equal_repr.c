@@ -16,6 +16,9 @@ ca_equal_repr(const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     ca_field_ptr field;
 
+    if (x == y)
+        return 1;
+
     /* by assumption: cached field objects are unique */
     if (x->field != y->field)
         return 0;
@@ -92,8 +92,8 @@ ca_is_fmpq_times_gen_as_ext(fmpq_t c, const ca_t x, ca_ctx_t ctx)
     return NULL;
 }
 
-void
-ca_exp(ca_t res, const ca_t x, ca_ctx_t ctx)
+static void
+_ca_exp_uncached(ca_t res, const ca_t x, ca_ctx_t ctx)
 {
     ca_ext_ptr ext;
 
@@ -302,3 +302,9 @@ ca_exp(ca_t res, const ca_t x, ca_ctx_t ctx)
     _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), CA_FIELD(res, ctx), ctx);
     ca_condense_field(res, ctx);
 }
+
+void
+ca_exp(ca_t res, const ca_t x, ca_ctx_t ctx)
+{
+    _ca_op_cached_unary(res, x, CA_Exp, _ca_exp_uncached, ctx);
+}
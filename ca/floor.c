@@ -34,7 +34,7 @@ ca_floor(ca_t res, const ca_t x, ca_ctx_t ctx)
     }
 
     {
-        slong prec, prec_limit;
+        slong prec, prec_limit, start_prec;
         acb_t v;
         mag_t m;
         fmpz_t n;
@@ -47,7 +47,9 @@ ca_floor(ca_t res, const ca_t x, ca_ctx_t ctx)
         prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
         prec_limit = FLINT_MAX(prec_limit, 64);
 
-        for (prec = 64; (prec <= prec_limit) && !success; prec *= 2)
+        start_prec = _ca_start_prec(x, ctx);
+
+        for (prec = start_prec; (prec <= prec_limit) && !success; prec *= 2)
         {
             ca_get_acb_raw(v, x, prec, ctx);
             arb_get_mag(m, acb_realref(v));
@@ -58,6 +60,7 @@ ca_floor(ca_t res, const ca_t x, ca_ctx_t ctx)
 
                 if (arb_get_unique_fmpz(n, acb_realref(v)))
                 {
+                    _ca_record_prec(x, prec, ctx);
                     ca_set_fmpz(res, n, ctx);
                     success = 1;
                     break;
@@ -13,6 +13,37 @@
 #include "ca.h"
 #include "ca_ext.h"
 
+/* Evaluates x, which must be an element of a number field or generic
+   field, given enclosures gens of the generators of its field. */
+void
+_ca_get_acb_raw_gens(acb_t res, const ca_t x, acb_srcptr gens, slong prec, ca_ctx_t ctx)
+{
+    ca_field_srcptr xfield;
+
+    xfield = CA_FIELD(x, ctx);
+
+    if (CA_FIELD_IS_NF(xfield))
+    {
+        if (CA_FIELD_NF(xfield)->flag & NF_LINEAR)
+            flint_abort();
+
+        if (CA_FIELD_NF(xfield)->flag & NF_QUADRATIC)
+        {
+            _arb_fmpz_poly_evaluate_acb(res, QNF_ELEM_NUMREF(CA_NF_ELEM(x)), 2, gens, prec);
+            acb_div_fmpz(res, res, QNF_ELEM_DENREF(CA_NF_ELEM(x)), prec);
+        }
+        else
+        {
+            _arb_fmpz_poly_evaluate_acb(res, NF_ELEM_NUMREF(CA_NF_ELEM(x)), NF_ELEM(CA_NF_ELEM(x))->length, gens, prec);
+            acb_div_fmpz(res, res, NF_ELEM_DENREF(CA_NF_ELEM(x)), prec);
+        }
+    }
+    else
+    {
+        fmpz_mpoly_q_evaluate_acb(res, CA_MPOLY_Q(x), gens, prec, CA_FIELD_MCTX(xfield, ctx));
+    }
+}
+
 void
 ca_get_acb_raw(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx)
 {
@@ -54,33 +85,29 @@ ca_get_acb_raw(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx)
 
     if (CA_FIELD_IS_NF(xfield))
     {
-        if (CA_FIELD_NF(xfield)->flag & NF_LINEAR)
-            flint_abort();
-
         ca_ext_get_acb_raw(res, CA_FIELD_EXT_ELEM(xfield, 0), prec, ctx);
-
-        if (CA_FIELD_NF(xfield)->flag & NF_QUADRATIC)
-        {
-            _arb_fmpz_poly_evaluate_acb(res, QNF_ELEM_NUMREF(CA_NF_ELEM(x)), 2, res, prec);
-            acb_div_fmpz(res, res, QNF_ELEM_DENREF(CA_NF_ELEM(x)), prec);
-        }
-        else
-        {
-            _arb_fmpz_poly_evaluate_acb(res, NF_ELEM_NUMREF(CA_NF_ELEM(x)), NF_ELEM(CA_NF_ELEM(x))->length, res, prec);
-            acb_div_fmpz(res, res, NF_ELEM_DENREF(CA_NF_ELEM(x)), prec);
-        }
+        _ca_get_acb_raw_gens(res, x, res, prec, ctx);
     }
     else
     {
         acb_ptr v;
         slong i, n;
+        ulong hash = 0;
+
+        if (ctx->options[CA_OPT_ACB_CACHE_SIZE] > 0)
+        {
+            hash = ca_hash_repr(x, ctx);
+
+            if (_ca_ctx_acb_cache_lookup(res, x, hash, prec, ctx))
+                return;
+        }
 
         n = CA_FIELD_LENGTH(xfield);
 
         if (n == 1)
         {
             ca_ext_get_acb_raw(res, CA_FIELD_EXT_ELEM(xfield, 0), prec, ctx);
-            fmpz_mpoly_q_evaluate_acb(res, CA_MPOLY_Q(x), res, prec, CA_FIELD_MCTX(xfield, ctx));
+            _ca_get_acb_raw_gens(res, x, res, prec, ctx);
         }
         else
         {
@@ -89,10 +116,12 @@ ca_get_acb_raw(acb_t res, const ca_t x, slong prec, ca_ctx_t ctx)
             for (i = 0; i < n; i++)
                 ca_ext_get_acb_raw(v + i, CA_FIELD_EXT_ELEM(xfield, i), prec, ctx);
 
-            fmpz_mpoly_q_evaluate_acb(res, CA_MPOLY_Q(x), v, prec, CA_FIELD_MCTX(xfield, ctx));
+            _ca_get_acb_raw_gens(res, x, v, prec, ctx);
 
             _acb_vec_clear(v, n);
         }
+
+        if (ctx->options[CA_OPT_ACB_CACHE_SIZE] > 0)
+            _ca_ctx_acb_cache_insert(x, hash, res, prec, ctx);
     }
 }
-
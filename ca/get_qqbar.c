@@ -12,6 +12,18 @@
 #include "ca.h"
 #include "ca_ext.h"
 
+static qqbar_srcptr
+_ca_ext_get_cached_qqbar(ca_ext_srcptr x, ca_ctx_t ctx)
+{
+    qqbar_srcptr res;
+
+    ca_ctx_lock(ctx);
+    res = x->data.func_data.qqbar;
+    ca_ctx_unlock(ctx);
+
+    return res;
+}
+
 int
 ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
 {
@@ -57,8 +69,9 @@ ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
         }
         else
         {
-            slong i, len, deg_limit, bits_limit;
+            slong i, len, deg_limit, bits_limit, work_limit, composed_degree;
             qqbar_ptr xs;
+            qqbar_srcptr cached;
             qqbar_t y, zero;
             int success;
             int * init_mask, * used;
@@ -93,9 +106,9 @@ ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
                 {
                     xs[i] = *CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i));
                 }
-                else if (CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar != NULL)
+                else if ((cached = _ca_ext_get_cached_qqbar(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i), ctx)) != NULL)
                 {
-                    xs[i] = *(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar);
+                    xs[i] = *cached;
                 }
                 else if (CA_EXT_HEAD(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)) == CA_Sqrt)
                 {
@@ -109,9 +122,16 @@ ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
                     qqbar_sqrt(xs + i, xs + i);
 
                     /* todo: avoid copy here... */
-                    CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar = flint_malloc(sizeof(qqbar_struct));
-                    qqbar_init(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar);
-                    qqbar_set(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar, xs + i);
+                    ca_ctx_lock(ctx);
+                    if (CA_CTX_OWNS(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i), ctx) &&
+                        CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar == NULL)
+                    {
+                        qqbar_ptr t = flint_malloc(sizeof(qqbar_struct));
+                        qqbar_init(t);
+                        qqbar_set(t, xs + i);
+                        CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)->data.func_data.qqbar = t;
+                    }
+                    ca_ctx_unlock(ctx);
 
                 }
                 else if (CA_EXT_HEAD(CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), i)) == CA_Abs)
@@ -236,6 +256,17 @@ ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
                 }
             }
 
+            /* Composed operations cannot be interrupted, so refuse
+               those whose degree would overrun the work budget. */
+            if (ca_ctx_budget_exceeded(ctx))
+                goto cleanup;
+
+            work_limit = ctx->options[CA_OPT_WORK_LIMIT];
+            if (work_limit > 0)
+                deg_limit = FLINT_MIN(deg_limit, FLINT_MAX(work_limit - ctx->budget_work, 1));
+
+            composed_degree = _qqbar_stats.composed_degree;
+
             if (qqbar_evaluate_fmpz_mpoly(y, fmpz_mpoly_q_numref(CA_MPOLY_Q(x)), xs, deg_limit, bits_limit, CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx)))
             {
                 if (qqbar_evaluate_fmpz_mpoly(res, fmpz_mpoly_q_denref(CA_MPOLY_Q(x)), xs, deg_limit, bits_limit, CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx)))
@@ -248,6 +279,8 @@ ca_get_qqbar(qqbar_t res, const ca_t x, ca_ctx_t ctx)
                 }
             }
 
+            _ca_ctx_budget_charge(ctx, _qqbar_stats.composed_degree - composed_degree);
+
 cleanup:
             for (i = 0; i < len; i++)
             {
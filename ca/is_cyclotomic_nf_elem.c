@@ -27,6 +27,17 @@ ca_is_cyclotomic_nf_elem(slong * p, ulong * q, const ca_t x, ca_ctx_t ctx)
         return 1;
     }
 
-    return CA_FIELD_IS_NF(CA_FIELD(x, ctx)) &&
-        qqbar_is_root_of_unity(p, q, CA_FIELD_NF_QQBAR(CA_FIELD(x, ctx)));
+    if (CA_FIELD_IS_NF(CA_FIELD(x, ctx)))
+    {
+        ca_ext_srcptr ext = CA_FIELD_EXT_ELEM(CA_FIELD(x, ctx), 0);
+
+        if (CA_EXT_QQBAR_ROOT_Q(ext) != 0)
+        {
+            if (p != NULL) p[0] = CA_EXT_QQBAR_ROOT_P(ext);
+            if (q != NULL) q[0] = CA_EXT_QQBAR_ROOT_Q(ext);
+            return 1;
+        }
+    }
+
+    return 0;
 }
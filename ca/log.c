@@ -192,8 +192,8 @@ ca_log_pow(ca_t res, const ca_t z, const ca_t a, ca_ctx_t ctx)
     ca_clear(pi, ctx);
 }
 
-void
-ca_log(ca_t res, const ca_t x, ca_ctx_t ctx)
+static void
+_ca_log_uncached(ca_t res, const ca_t x, ca_ctx_t ctx)
 {
     truth_t is_zero;
     ca_ext_ptr ext;
@@ -354,3 +354,9 @@ ca_log(ca_t res, const ca_t x, ca_ctx_t ctx)
     _ca_make_field_element(res, _ca_ctx_get_field_fx(ctx, CA_Log, x), ctx);
     fmpz_mpoly_q_gen(CA_MPOLY_Q(res), 0, CA_MCTX_1(ctx));
 }
+
+void
+ca_log(ca_t res, const ca_t x, ca_ctx_t ctx)
+{
+    _ca_op_cached_unary(res, x, CA_Log, _ca_log_uncached, ctx);
+}
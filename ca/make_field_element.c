@@ -52,4 +52,5 @@ _ca_make_field_element(ca_t x, ca_field_srcptr field, ca_ctx_t ctx)
     }
 
     x->field = (ulong) field;
+    _ca_field_incref(field, ctx);
 }
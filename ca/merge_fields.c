@@ -47,40 +47,19 @@ _nf_elem_get_fmpz_poly_den_shallow(fmpz_poly_t pol, fmpz_t den, const nf_elem_t
     pol->alloc = pol->length;
 }
 
-
-void
-ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
+/* Merges the generator lists of xfield and yfield, setting xgen_map and
+   ygen_map to the positions of their generators in the merged list. */
+static ca_field_srcptr
+_ca_merge_fields_uncached(slong * xgen_map, slong * ygen_map,
+    ca_field_srcptr xfield, ca_field_srcptr yfield, ca_ctx_t ctx)
 {
-    ca_field_srcptr xfield, yfield, field;
+    ca_field_srcptr field;
     ca_ext_struct ** ext;
-    slong *xgen_map, *ygen_map;
     slong xlen, ylen, ext_len;
     slong ext_alloc;
     slong ix, iy;
     int cmp;
 
-    if (CA_IS_SPECIAL(x) || CA_IS_SPECIAL(y))
-    {
-        flint_printf("ca_merge_fields: inputs must be field elements, not special values\n");
-        flint_abort();
-    }
-
-    xfield = CA_FIELD(x, ctx);
-    yfield = CA_FIELD(y, ctx);
-
-    if (xfield == yfield || CA_FIELD_IS_QQ(xfield) || CA_FIELD_IS_QQ(yfield))
-    {
-        ca_set(resx, x, ctx);
-        ca_set(resy, y, ctx);
-        return;
-    }
-
-    if (x == resx || y == resy)
-    {
-        flint_printf("ca_merge_fields: aliasing not implemented!\n");
-        flint_abort();
-    }
-
     xlen = CA_FIELD_LENGTH(xfield);
     ylen = CA_FIELD_LENGTH(yfield);
 
@@ -88,9 +67,6 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
     ext = flint_malloc(ext_alloc * sizeof(ca_ext_struct *));
     ext_len = 0;
 
-    xgen_map = flint_malloc(xlen * sizeof(slong));
-    ygen_map = flint_malloc(ylen * sizeof(slong));
-
 /*
     printf("merge fields of len %ld and len %ld\n", xlen, ylen);
     for (ix = 0; ix < xlen; ix++)
@@ -161,6 +137,193 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
 
     field = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), ext, ext_len, ctx);
 
+    flint_free(ext);
+
+    return field;
+}
+
+/* Evaluates f at the images of the generators, given as polynomials in
+   the generator of nf. */
+static void
+_nf_elem_set_fmpz_mpoly_images(nf_elem_t res, const fmpz_mpoly_t f,
+    const slong * gen_map, const fmpq_poly_struct * images,
+    const fmpz_mpoly_ctx_t mctx, const nf_t nf)
+{
+    slong i, j, nvars;
+    ulong * exp;
+    nf_elem_struct * vals;
+    nf_elem_t t, u;
+    fmpz_t c;
+
+    nvars = mctx->minfo->nvars;
+
+    exp = flint_malloc(sizeof(ulong) * nvars);
+    vals = flint_malloc(sizeof(nf_elem_struct) * nvars);
+    nf_elem_init(t, nf);
+    nf_elem_init(u, nf);
+    fmpz_init(c);
+
+    for (j = 0; j < nvars; j++)
+    {
+        nf_elem_init(vals + j, nf);
+        nf_elem_set_fmpq_poly(vals + j, images + gen_map[j], nf);
+    }
+
+    nf_elem_zero(res, nf);
+
+    for (i = 0; i < fmpz_mpoly_length(f, mctx); i++)
+    {
+        fmpz_mpoly_get_term_exp_ui(exp, f, i, mctx);
+        fmpz_mpoly_get_term_coeff_fmpz(c, f, i, mctx);
+        nf_elem_set_fmpz(t, c, nf);
+
+        for (j = 0; j < nvars; j++)
+        {
+            if (exp[j] != 0)
+            {
+                nf_elem_pow(u, vals + j, exp[j], nf);
+                nf_elem_mul(t, t, u, nf);
+            }
+        }
+
+        nf_elem_add(res, res, t, nf);
+    }
+
+    for (j = 0; j < nvars; j++)
+        nf_elem_clear(vals + j, nf);
+
+    flint_free(exp);
+    flint_free(vals);
+    nf_elem_clear(t, nf);
+    nf_elem_clear(u, nf);
+    fmpz_clear(c);
+}
+
+/* Sets res to x represented in the number field nf of a primitive element
+   of the merged field, given the positions gen_map of the generators of
+   the field of x and the images of the generators of the merged field. */
+static void
+_ca_set_primitive(ca_t res, const ca_t x, const slong * gen_map,
+    const fmpq_poly_struct * images, ca_field_srcptr nf, ca_ctx_t ctx)
+{
+    ca_field_srcptr xfield;
+
+    xfield = CA_FIELD(x, ctx);
+
+    if (xfield == nf)
+    {
+        ca_set(res, x, ctx);
+        return;
+    }
+
+    _ca_make_field_element(res, nf, ctx);
+
+    if (CA_FIELD_IS_NF(xfield))
+    {
+        fmpq_poly_t pol;
+
+        fmpq_poly_init(pol);
+        nf_elem_get_fmpq_poly(pol, CA_NF_ELEM(x), CA_FIELD_NF(xfield));
+        fmpq_poly_compose_mod(pol, pol, images + gen_map[0], CA_FIELD_NF(nf)->pol);
+        nf_elem_set_fmpq_poly(CA_NF_ELEM(res), pol, CA_FIELD_NF(nf));
+        fmpq_poly_clear(pol);
+    }
+    else
+    {
+        nf_elem_t den;
+
+        nf_elem_init(den, CA_FIELD_NF(nf));
+
+        _nf_elem_set_fmpz_mpoly_images(CA_NF_ELEM(res), fmpz_mpoly_q_numref(CA_MPOLY_Q(x)),
+            gen_map, images, CA_FIELD_MCTX(xfield, ctx), CA_FIELD_NF(nf));
+        _nf_elem_set_fmpz_mpoly_images(den, fmpz_mpoly_q_denref(CA_MPOLY_Q(x)),
+            gen_map, images, CA_FIELD_MCTX(xfield, ctx), CA_FIELD_NF(nf));
+        nf_elem_div(CA_NF_ELEM(res), CA_NF_ELEM(res), den, CA_FIELD_NF(nf));
+
+        nf_elem_clear(den, CA_FIELD_NF(nf));
+    }
+}
+
+/* If all generators of the merged field are algebraic, tries to set resx
+   and resy to x and y represented in the number field of a primitive
+   element, so that arithmetic uses nf_elem instead of reduction by the
+   ideal. */
+static int
+_ca_merge_fields_primitive(ca_t resx, ca_t resy, const ca_t x, const ca_t y,
+    const slong * xgen_map, const slong * ygen_map, ca_field_srcptr field, ca_ctx_t ctx)
+{
+    fmpq_poly_struct * images;
+    ca_field_srcptr nf;
+    slong i, len;
+
+    len = CA_FIELD_LENGTH(field);
+
+    for (i = 0; i < len; i++)
+        if (!CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(field, i)))
+            return 0;
+
+    images = flint_malloc(sizeof(fmpq_poly_struct) * len);
+    for (i = 0; i < len; i++)
+        fmpq_poly_init(images + i);
+
+    nf = _ca_ctx_get_field_primitive(images, field, ctx);
+
+    if (nf != NULL)
+    {
+        _ca_set_primitive(resx, x, xgen_map, images, nf, ctx);
+        _ca_set_primitive(resy, y, ygen_map, images, nf, ctx);
+    }
+
+    for (i = 0; i < len; i++)
+        fmpq_poly_clear(images + i);
+    flint_free(images);
+
+    return nf != NULL;
+}
+
+void
+ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    ca_field_srcptr xfield, yfield, field;
+    slong *xgen_map, *ygen_map;
+    slong xlen, ylen;
+
+    if (CA_IS_SPECIAL(x) || CA_IS_SPECIAL(y))
+    {
+        flint_printf("ca_merge_fields: inputs must be field elements, not special values\n");
+        flint_abort();
+    }
+
+    xfield = CA_FIELD(x, ctx);
+    yfield = CA_FIELD(y, ctx);
+
+    if (xfield == yfield || CA_FIELD_IS_QQ(xfield) || CA_FIELD_IS_QQ(yfield))
+    {
+        ca_set(resx, x, ctx);
+        ca_set(resy, y, ctx);
+        return;
+    }
+
+    if (x == resx || y == resy)
+    {
+        flint_printf("ca_merge_fields: aliasing not implemented!\n");
+        flint_abort();
+    }
+
+    xlen = CA_FIELD_LENGTH(xfield);
+    ylen = CA_FIELD_LENGTH(yfield);
+
+    xgen_map = flint_malloc(xlen * sizeof(slong));
+    ygen_map = flint_malloc(ylen * sizeof(slong));
+
+    field = _ca_ctx_merge_cache_lookup(xgen_map, ygen_map, xfield, yfield, ctx);
+
+    if (field == NULL)
+    {
+        field = _ca_merge_fields_uncached(xgen_map, ygen_map, xfield, yfield, ctx);
+        _ca_ctx_merge_cache_insert(xfield, yfield, field, xgen_map, ygen_map, ctx);
+    }
+
 /*
     printf("MERGE FIELDS:\n");
     if (CA_FIELD_LENGTH(xfield) > 100) flint_abort();
@@ -171,6 +334,14 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
     ca_field_print(field, ctx); printf("\n\n");
 */
 
+    if (CA_FIELD_IS_GENERIC(field) && ctx->options[CA_OPT_PRIMITIVE_DEG_LIMIT] > 0 &&
+        _ca_merge_fields_primitive(resx, resy, x, y, xgen_map, ygen_map, field, ctx))
+    {
+        flint_free(xgen_map);
+        flint_free(ygen_map);
+        return;
+    }
+
     if (xfield == field)
     {
         ca_set(resx, x, ctx);
@@ -241,7 +412,6 @@ ca_merge_fields(ca_t resx, ca_t resy, const ca_t x, const ca_t y, ca_ctx_t ctx)
         }
     }
 
-    flint_free(ext);
     flint_free(xgen_map);
     flint_free(ygen_map);
 }
@@ -0,0 +1,200 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+void _nf_elem_get_fmpz_poly_den_shallow(fmpz_poly_t pol, fmpz_t den, const nf_elem_t a, const nf_t nf);
+
+/* Merges two generator lists sorted as in ca_merge_fields
+   (more complex first), removing duplicates. */
+static slong
+_ca_ext_vec_merge(ca_ext_struct ** res, ca_ext_struct ** a, slong alen, ca_ext_struct ** b, slong blen, ca_ctx_t ctx)
+{
+    slong i, j, len;
+    int cmp;
+
+    i = j = len = 0;
+
+    while (i < alen || j < blen)
+    {
+        if (i < alen && j < blen)
+        {
+            cmp = -ca_ext_cmp_repr(a[i], b[j], ctx);
+
+            if (cmp == 0)
+            {
+                res[len++] = a[i];
+                i++;
+                j++;
+            }
+            else if (cmp < 0)
+                res[len++] = a[i++];
+            else
+                res[len++] = b[j++];
+        }
+        else if (i < alen)
+            res[len++] = a[i++];
+        else
+            res[len++] = b[j++];
+    }
+
+    return len;
+}
+
+static slong
+_ca_ext_vec_index(ca_ext_struct ** ext, slong len, ca_ext_srcptr x)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (ext[i] == x)
+            return i;
+
+    flint_abort();
+    return -1;
+}
+
+ca_field_srcptr
+_ca_merge_fields_vec(ca_ptr res, ca_srcptr x, slong len, ca_ctx_t ctx)
+{
+    ca_field_srcptr field, xfield, prev;
+    ca_ext_struct ** ext;
+    ca_ext_struct ** tmp;
+    ca_ext_struct ** swap;
+    slong * gen_map;
+    slong i, j, ext_len, ext_alloc;
+    fmpz_mpoly_ctx_struct * mctx;
+
+    ext_alloc = 0;
+    for (i = 0; i < len; i++)
+    {
+        if (CA_IS_SPECIAL(x + i))
+        {
+            flint_printf("_ca_merge_fields_vec: inputs must be field elements, not special values\n");
+            flint_abort();
+        }
+
+        ext_alloc += CA_FIELD_LENGTH(CA_FIELD(x + i, ctx));
+    }
+
+    ext_alloc = FLINT_MAX(ext_alloc, 1);
+    ext = flint_malloc(sizeof(ca_ext_struct *) * ext_alloc);
+    tmp = flint_malloc(sizeof(ca_ext_struct *) * ext_alloc);
+    gen_map = flint_malloc(sizeof(slong) * ext_alloc);
+    ext_len = 0;
+
+    /* Union of the generators, without building intermediate fields. */
+    prev = NULL;
+    for (i = 0; i < len; i++)
+    {
+        xfield = CA_FIELD(x + i, ctx);
+
+        if (xfield == prev || CA_FIELD_IS_QQ(xfield))
+            continue;
+
+        ext_len = _ca_ext_vec_merge(tmp, ext, ext_len, CA_FIELD_EXT(xfield), CA_FIELD_LENGTH(xfield), ctx);
+        swap = ext;
+        ext = tmp;
+        tmp = swap;
+        prev = xfield;
+    }
+
+    if (ext_len == 0)
+        field = ctx->field_qq;
+    else
+        field = ca_field_cache_insert_ext(CA_CTX_FIELD_CACHE(ctx), ext, ext_len, ctx);
+
+    if (!CA_FIELD_IS_GENERIC(field))
+    {
+        for (i = 0; i < len; i++)
+            ca_set(res + i, x + i, ctx);
+    }
+    else
+    {
+        mctx = CA_FIELD_MCTX(field, ctx);
+
+        for (i = 0; i < len; i++)
+        {
+            xfield = CA_FIELD(x + i, ctx);
+
+            if (xfield == field)
+            {
+                ca_set(res + i, x + i, ctx);
+            }
+            else if (CA_FIELD_IS_QQ(xfield))
+            {
+                _ca_make_field_element(res + i, field, ctx);
+                fmpz_mpoly_q_set_fmpq(CA_MPOLY_Q(res + i), CA_FMPQ(x + i), mctx);
+            }
+            else if (CA_FIELD_IS_NF(xfield))
+            {
+                fmpz_poly_t pol;
+                fmpz_t den;
+
+                _ca_make_field_element(res + i, field, ctx);
+                _nf_elem_get_fmpz_poly_den_shallow(pol, den, CA_NF_ELEM(x + i), CA_FIELD_NF(xfield));
+                j = _ca_ext_vec_index(ext, ext_len, CA_FIELD_EXT_ELEM(xfield, 0));
+
+                fmpz_mpoly_set_gen_fmpz_poly(fmpz_mpoly_q_numref(CA_MPOLY_Q(res + i)), j, pol, mctx);
+                fmpz_mpoly_set_fmpz(fmpz_mpoly_q_denref(CA_MPOLY_Q(res + i)), den, mctx);
+            }
+            else
+            {
+                for (j = 0; j < CA_FIELD_LENGTH(xfield); j++)
+                    gen_map[j] = _ca_ext_vec_index(ext, ext_len, CA_FIELD_EXT_ELEM(xfield, j));
+
+                _ca_make_field_element(res + i, field, ctx);
+
+                fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_q_numref(CA_MPOLY_Q(res + i)),
+                    fmpz_mpoly_q_numref(CA_MPOLY_Q(x + i)), gen_map, CA_FIELD_MCTX(xfield, ctx), mctx);
+                fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_q_denref(CA_MPOLY_Q(res + i)),
+                    fmpz_mpoly_q_denref(CA_MPOLY_Q(x + i)), gen_map, CA_FIELD_MCTX(xfield, ctx), mctx);
+            }
+        }
+    }
+
+    flint_free(ext);
+    flint_free(tmp);
+    flint_free(gen_map);
+
+    return field;
+}
+
+void
+ca_merge_fields_vec(ca_ptr res, ca_srcptr x, slong len, ca_ctx_t ctx)
+{
+    slong i;
+
+    if (res == x)
+    {
+        ca_ptr t;
+
+        t = flint_malloc(sizeof(ca_struct) * len);
+        for (i = 0; i < len; i++)
+            ca_init(t + i, ctx);
+
+        _ca_merge_fields_vec(t, x, len, ctx);
+
+        for (i = 0; i < len; i++)
+        {
+            ca_swap(res + i, t + i, ctx);
+            ca_clear(t + i, ctx);
+        }
+
+        flint_free(t);
+    }
+    else
+    {
+        _ca_merge_fields_vec(res, x, len, ctx);
+    }
+}
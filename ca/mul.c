@@ -96,8 +96,8 @@ ca_mul_si(ca_t res, const ca_t x, slong y, ca_ctx_t ctx)
     fmpz_clear(t);
 }
 
-void
-ca_mul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+static void
+_ca_mul_uncached(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     ca_field_srcptr xfield, yfield, zfield;
 
@@ -248,6 +248,11 @@ ca_mul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
         else
         {
             fmpz_mpoly_q_mul(CA_MPOLY_Q(res), CA_MPOLY_Q(x), CA_MPOLY_Q(y), CA_FIELD_MCTX(zfield, ctx));
+
+            /* inside a reduction batch; see ca_reduce */
+            if (_ca_reduction_deferred(res, ctx))
+                return;
+
             _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), zfield, ctx);
             _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), zfield, ctx);
         }
@@ -272,3 +277,9 @@ ca_mul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
     }
 }
 
+void
+ca_mul(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    _ca_op_cached_binary(res, x, y, CA_Mul, _ca_mul_uncached, ctx);
+}
+
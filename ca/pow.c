@@ -438,8 +438,8 @@ ca_pow_fmpz(ca_t res, const ca_t x, const fmpz_t y, ca_ctx_t ctx)
 }
 
 
-void
-ca_pow(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+static void
+_ca_pow_uncached(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
 {
     if (CA_IS_QQ(y, ctx) && fmpz_is_one(CA_FMPQ_DENREF(y)))
     {
@@ -483,6 +483,12 @@ ca_pow(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
     _ca_pow_general(res, x, y, ctx);
 }
 
+void
+ca_pow(ca_t res, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    _ca_op_cached_binary(res, x, y, CA_Pow, _ca_pow_uncached, ctx);
+}
+
 void
 ca_pow_fmpq(ca_t res, const ca_t x, const fmpq_t y, ca_ctx_t ctx)
 {
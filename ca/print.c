@@ -512,7 +512,7 @@ ca_all_extensions(ca_ext_ptr ** extensions, slong * length, const ca_t x, ca_ctx
 }
 
 void
-ca_write(calcium_stream_t out, const ca_t x, ca_ctx_t ctx)
+_ca_write(calcium_stream_t out, const ca_t x, ulong flags, ca_ctx_t ctx)
 {
     ca_print_info_t info;
 
@@ -544,8 +544,8 @@ ca_write(calcium_stream_t out, const ca_t x, ca_ctx_t ctx)
     info.ext = ext;
     info.ext_len = len;
     info.ext_vars = vars;
-    info.flags = ctx->options[CA_OPT_PRINT_FLAGS];
-    info.digits = ctx->options[CA_OPT_PRINT_FLAGS] / CA_PRINT_DIGITS;
+    info.flags = flags;
+    info.digits = flags / CA_PRINT_DIGITS;
     if (info.digits == 0)
         info.digits = 6;
     info.print_where = 1;
@@ -557,6 +557,12 @@ ca_write(calcium_stream_t out, const ca_t x, ca_ctx_t ctx)
     flint_free(ext);
 }
 
+void
+ca_write(calcium_stream_t out, const ca_t x, ca_ctx_t ctx)
+{
+    _ca_write(out, x, ctx->options[CA_OPT_PRINT_FLAGS], ctx);
+}
+
 char * ca_get_str(const ca_t x, ca_ctx_t ctx)
 {
     calcium_stream_t out;
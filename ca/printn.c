@@ -11,12 +11,14 @@
 
 #include "ca.h"
 
+/* The print flags are passed down rather than written to the options,
+   which other threads may be reading. */
 void
 ca_printn(const ca_t x, slong n, ca_ctx_t ctx)
 {
-    ulong save_flags;
-    save_flags = ctx->options[CA_OPT_PRINT_FLAGS];
-    ctx->options[CA_OPT_PRINT_FLAGS] = CA_PRINT_N | (CA_PRINT_DIGITS * n);
-    ca_print(x, ctx);
-    ctx->options[CA_OPT_PRINT_FLAGS] = save_flags;
+    calcium_stream_t out;
+    calcium_stream_init_str(out);
+    _ca_write(out, x, CA_PRINT_N | (CA_PRINT_DIGITS * n), ctx);
+    flint_printf("%s", out->s);
+    flint_free(out->s);
 }
@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+/* The batch depths are kept per thread (and per context), since a
+   context may be shared between threads in thread-safe mode. */
+typedef struct
+{
+    const ca_ctx_struct * ctx;
+    slong depth;
+}
+ca_reduction_batch_struct;
+
+static FLINT_TLS_PREFIX ca_reduction_batch_struct * _ca_batches = NULL;
+static FLINT_TLS_PREFIX slong _ca_batches_len = 0;
+static FLINT_TLS_PREFIX slong _ca_batches_alloc = 0;
+
+slong
+_ca_ctx_reduction_batch_depth(const ca_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < _ca_batches_len; i++)
+        if (_ca_batches[i].ctx == ctx)
+            return _ca_batches[i].depth;
+
+    return 0;
+}
+
+void
+_ca_ctx_set_reduction_batch_depth(const ca_ctx_t ctx, slong depth)
+{
+    slong i;
+
+    for (i = 0; i < _ca_batches_len; i++)
+        if (_ca_batches[i].ctx == ctx)
+            break;
+
+    if (i == _ca_batches_len)
+    {
+        if (depth == 0)
+            return;
+
+        if (_ca_batches_len == _ca_batches_alloc)
+        {
+            _ca_batches_alloc = FLINT_MAX(4, 2 * _ca_batches_alloc);
+            _ca_batches = flint_realloc(_ca_batches, sizeof(ca_reduction_batch_struct) * _ca_batches_alloc);
+        }
+
+        _ca_batches[i].ctx = ctx;
+        _ca_batches_len++;
+    }
+
+    _ca_batches[i].depth = depth;
+
+    if (depth == 0)
+    {
+        _ca_batches[i] = _ca_batches[_ca_batches_len - 1];
+        _ca_batches_len--;
+
+        if (_ca_batches_len == 0)
+        {
+            flint_free(_ca_batches);
+            _ca_batches = NULL;
+            _ca_batches_alloc = 0;
+        }
+    }
+}
+
+void
+ca_ctx_begin_reduction_batch(ca_ctx_t ctx)
+{
+    _ca_ctx_set_reduction_batch_depth(ctx, _ca_ctx_reduction_batch_depth(ctx) + 1);
+}
+
+void
+ca_ctx_end_reduction_batch(ca_ctx_t ctx)
+{
+    slong depth = _ca_ctx_reduction_batch_depth(ctx);
+
+    if (depth <= 0)
+    {
+        flint_printf("ca_ctx_end_reduction_batch: no batch in progress\n");
+        flint_abort();
+    }
+
+    _ca_ctx_set_reduction_batch_depth(ctx, depth - 1);
+}
+
+int
+_ca_reduction_deferred(const ca_t x, ca_ctx_t ctx)
+{
+    const fmpz_mpoly_q_struct * f;
+
+    if (_ca_batches_len == 0 || _ca_ctx_reduction_batch_depth(ctx) == 0)
+        return 0;
+
+    f = CA_MPOLY_Q(x);
+
+    return fmpz_mpoly_length(fmpz_mpoly_q_numref(f), CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx)) +
+           fmpz_mpoly_length(fmpz_mpoly_q_denref(f), CA_FIELD_MCTX(CA_FIELD(x, ctx), ctx))
+            <= ctx->options[CA_OPT_REDUCTION_BATCH_LENGTH];
+}
+
+void
+ca_reduce(ca_t x, ca_ctx_t ctx)
+{
+    ca_field_srcptr K;
+
+    if (CA_IS_SPECIAL(x))
+    {
+        if (CA_IS_SIGNED_INF(x))
+        {
+            ca_t t;
+            *t = *x;
+            t->field &= ~CA_INF;
+            ca_reduce(t, ctx);
+            t->field |= CA_INF;
+            *x = *t;
+        }
+
+        return;
+    }
+
+    K = CA_FIELD(x, ctx);
+
+    if (CA_FIELD_IS_GENERIC(K))
+    {
+        _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(x), K, ctx);
+        _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(x), K, ctx);
+    }
+
+    ca_condense_field(x, ctx);
+}
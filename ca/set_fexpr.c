@@ -229,21 +229,31 @@ _ca_set_fexpr(ca_t res, fexpr_vec_t inputs, ca_vec_t outputs, const fexpr_t expr
                     return 1;
                 }
 
-                fexpr_view_arg(arg, expr, 0);
-                success = _ca_set_fexpr(res, inputs, outputs, arg, ctx);
+                if (nargs == 1)
+                {
+                    fexpr_view_arg(arg, expr, 0);
+                    return _ca_set_fexpr(res, inputs, outputs, arg, ctx);
+                }
 
-                if (success && nargs > 1)
                 {
-                    /* todo: divide and conquer for large nargs? */
-                    ca_init(t, ctx);
+                    ca_ptr v;
+
+                    v = _ca_vec_init(nargs, ctx);
+
+                    fexpr_view_arg(arg, expr, 0);
+                    success = _ca_set_fexpr(v, inputs, outputs, arg, ctx);
+
                     for (i = 1; i < nargs && success; i++)
                     {
                         fexpr_view_next(arg);
-                        success = _ca_set_fexpr(t, inputs, outputs, arg, ctx);
-                        if (success)
-                            ca_add(res, res, t, ctx);
+                        success = _ca_set_fexpr(v + i, inputs, outputs, arg, ctx);
                     }
-                    ca_clear(t, ctx);
+
+                    /* all terms are lifted to a common field at once */
+                    if (success)
+                        _ca_vec_sum(res, v, nargs, ctx);
+
+                    _ca_vec_clear(v, nargs, ctx);
                 }
                 return success;
 
@@ -254,21 +264,31 @@ _ca_set_fexpr(ca_t res, fexpr_vec_t inputs, ca_vec_t outputs, const fexpr_t expr
                     return 1;
                 }
 
-                fexpr_view_arg(arg, expr, 0);
-                success = _ca_set_fexpr(res, inputs, outputs, arg, ctx);
+                if (nargs == 1)
+                {
+                    fexpr_view_arg(arg, expr, 0);
+                    return _ca_set_fexpr(res, inputs, outputs, arg, ctx);
+                }
 
-                if (success && nargs > 1)
                 {
-                    /* todo: divide and conquer for large nargs? */
-                    ca_init(t, ctx);
+                    ca_ptr v;
+
+                    v = _ca_vec_init(nargs, ctx);
+
+                    fexpr_view_arg(arg, expr, 0);
+                    success = _ca_set_fexpr(v, inputs, outputs, arg, ctx);
+
                     for (i = 1; i < nargs && success; i++)
                     {
                         fexpr_view_next(arg);
-                        success = _ca_set_fexpr(t, inputs, outputs, arg, ctx);
-                        if (success)
-                            ca_mul(res, res, t, ctx);
+                        success = _ca_set_fexpr(v + i, inputs, outputs, arg, ctx);
                     }
-                    ca_clear(t, ctx);
+
+                    /* all terms are lifted to a common field at once */
+                    if (success)
+                        _ca_vec_prod(res, v, nargs, ctx);
+
+                    _ca_vec_clear(v, nargs, ctx);
                 }
                 return success;
         }
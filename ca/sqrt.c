@@ -98,8 +98,8 @@ ca_sqrt_nofactor(ca_t res, const ca_t x, ca_ctx_t ctx)
     }
 }
 
-void
-ca_sqrt(ca_t res, const ca_t x, ca_ctx_t ctx)
+static void
+_ca_sqrt_uncached(ca_t res, const ca_t x, ca_ctx_t ctx)
 {
 #if 0
     ca_sqrt_nofactor(res, x, ctx);
@@ -108,3 +108,9 @@ ca_sqrt(ca_t res, const ca_t x, ca_ctx_t ctx)
 #endif
 }
 
+void
+ca_sqrt(ca_t res, const ca_t x, ca_ctx_t ctx)
+{
+    _ca_op_cached_unary(res, x, CA_Sqrt, _ca_sqrt_uncached, ctx);
+}
+
@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+/* Estimate of the number of bits lost to cancellation when evaluating x
+   numerically: coefficient sizes, number of terms, degree and the
+   nesting depth of the generators. */
+static slong
+_ca_cancellation_bits(const ca_t x, ca_ctx_t ctx)
+{
+    ca_field_srcptr K;
+    slong i, bits, depth;
+
+    K = CA_FIELD(x, ctx);
+
+    if (CA_FIELD_IS_NF(K))
+    {
+        const fmpz * num;
+        slong len;
+
+        if (CA_FIELD_NF(K)->flag & NF_LINEAR)
+            return 0;
+
+        if (CA_FIELD_NF(K)->flag & NF_QUADRATIC)
+        {
+            num = QNF_ELEM_NUMREF(CA_NF_ELEM(x));
+            len = 2;
+        }
+        else
+        {
+            num = NF_ELEM_NUMREF(CA_NF_ELEM(x));
+            len = NF_ELEM(CA_NF_ELEM(x))->length;
+        }
+
+        bits = FLINT_ABS(_fmpz_vec_max_bits(num, len));
+        bits += FLINT_BIT_COUNT(len);
+    }
+    else
+    {
+        const fmpz_mpoly_struct * num;
+        const fmpz_mpoly_ctx_struct * mctx;
+
+        num = fmpz_mpoly_q_numref(CA_MPOLY_Q(x));
+        mctx = CA_FIELD_MCTX(K, ctx);
+
+        bits = FLINT_ABS(fmpz_mpoly_max_bits(num));
+        bits += FLINT_BIT_COUNT(fmpz_mpoly_length(num, mctx));
+        bits += FLINT_BIT_COUNT(fmpz_mpoly_total_degree_si(num, mctx));
+
+        depth = 0;
+        for (i = 0; i < CA_FIELD_LENGTH(K); i++)
+            depth = FLINT_MAX(depth, CA_EXT_DEPTH(CA_FIELD_EXT_ELEM(K, i)));
+
+        bits += 4 * depth;
+    }
+
+    return bits;
+}
+
+/* Starting precision for a numerical test of x, doubling from 64 bits
+   until enough bits survive cancellation. Previous decisions in the
+   same field raise the estimate; the generator enclosures computed for
+   them are cached, so evaluating at that precision again is cheap. */
+slong
+_ca_start_prec(const ca_t x, ca_ctx_t ctx)
+{
+    slong prec, prec_limit, loss, hint;
+
+    prec = 64;
+
+    if (CA_IS_SPECIAL(x) || CA_IS_QQ(x, ctx))
+        return prec;
+
+    prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
+    prec_limit = FLINT_MAX(prec_limit, 64);
+
+    loss = _ca_cancellation_bits(x, ctx);
+
+    ca_ctx_lock(ctx);
+    hint = CA_FIELD(x, ctx)->prec_hint;
+    ca_ctx_unlock(ctx);
+
+    while (prec < hint || prec - loss < 32)
+    {
+        if (2 * prec > prec_limit)
+            break;
+
+        prec *= 2;
+    }
+
+    return prec;
+}
+
+/* Remember that a numerical test of x was decided at precision prec.
+   A decision at or below the current hint lets the hint decay, so that
+   a single hard case does not slow down later easy ones. */
+void
+_ca_record_prec(const ca_t x, slong prec, ca_ctx_t ctx)
+{
+    ca_field_struct * K;
+
+    if (CA_IS_SPECIAL(x) || CA_IS_QQ(x, ctx))
+        return;
+
+    K = CA_FIELD(x, ctx);
+
+    if (!CA_CTX_OWNS(K, ctx))
+        return;
+
+    ca_ctx_lock(ctx);
+    if (prec <= K->prec_hint)
+        K->prec_hint /= 2;
+    else
+        K->prec_hint = prec;
+    ca_ctx_unlock(ctx);
+}
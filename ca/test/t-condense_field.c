@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("condense_field....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    {
+        ca_ctx_t ctx;
+        ca_t a, b, c, s;
+
+        ca_ctx_init(ctx);
+        ca_init(a, ctx);
+        ca_init(b, ctx);
+        ca_init(c, ctx);
+        ca_init(s, ctx);
+
+        ca_pi(a, ctx);
+        ca_euler(b, ctx);
+        ca_set_ui(c, 2, ctx);
+        ca_log(c, c, ctx);
+
+        ca_add(s, a, b, ctx);
+        ca_add(s, s, c, ctx);
+        ca_sub(s, s, c, ctx);
+
+        if (CA_IS_SPECIAL(s) || CA_FIELD_LENGTH(CA_FIELD(s, ctx)) != 2)
+        {
+            flint_printf("FAIL: pi + euler\n");
+            ca_print(s, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_clear(a, ctx);
+        ca_clear(b, ctx);
+        ca_clear(c, ctx);
+        ca_clear(s, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    /* a parent with live forks can still insert new subfields */
+    {
+        ca_ctx_t ctx, fork;
+        ca_t a, b, c, s, t;
+
+        ca_ctx_init(ctx);
+        ca_init(a, ctx);
+        ca_init(b, ctx);
+        ca_init(c, ctx);
+        ca_init(s, ctx);
+        ca_init(t, ctx);
+
+        ca_pi(a, ctx);
+        ca_euler(b, ctx);
+        ca_set_ui(c, 2, ctx);
+        ca_log(c, c, ctx);
+
+        /* creates Q(pi, log(2)) and Q(pi, euler, log(2)) but not Q(pi, euler) */
+        ca_add(s, a, c, ctx);
+        ca_add(s, s, b, ctx);
+
+        ca_ctx_fork(fork, ctx);
+
+        ca_sub(t, s, c, ctx);
+
+        if (CA_IS_SPECIAL(t) || CA_FIELD_LENGTH(CA_FIELD(t, ctx)) != 2)
+        {
+            flint_printf("FAIL: fork (uncached subfield)\n");
+            ca_print(t, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_sub(t, t, b, ctx);
+
+        if (ca_check_equal(t, a, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL: fork (equality)\n");
+            ca_print(t, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_ctx_clear(fork);
+
+        ca_clear(a, ctx);
+        ca_clear(b, ctx);
+        ca_clear(c, ctx);
+        ca_clear(s, ctx);
+        ca_clear(t, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y, z, s, t;
+        int * used;
+        slong i, nvars;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(s, ctx);
+        ca_init(t, ctx);
+
+        ca_randtest(x, state, 2, 5, ctx);
+        ca_randtest(y, state, 2, 5, ctx);
+        ca_randtest(z, state, 2, 5, ctx);
+
+        /* the generators of z should be dropped again */
+        ca_add(s, x, z, ctx);
+        ca_add(s, s, y, ctx);
+        ca_sub(s, s, z, ctx);
+        ca_add(t, x, y, ctx);
+
+        if (ca_check_equal(s, t, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: equality\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n");
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* a condensed element uses all generators of its field */
+        if (!CA_IS_SPECIAL(s) && CA_FIELD_IS_GENERIC(CA_FIELD(s, ctx)))
+        {
+            nvars = CA_FIELD_LENGTH(CA_FIELD(s, ctx));
+            used = flint_malloc(sizeof(int) * nvars);
+            fmpz_mpoly_q_used_vars(used, CA_MPOLY_Q(s), CA_FIELD_MCTX(CA_FIELD(s, ctx), ctx));
+
+            for (i = 0; i < nvars; i++)
+            {
+                if (!used[i])
+                {
+                    flint_printf("FAIL: unused generator\n");
+                    flint_printf("s = "); ca_print(s, ctx); flint_printf("\n");
+                    flint_abort();
+                }
+            }
+
+            flint_free(used);
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(s, ctx);
+        ca_clear(t, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
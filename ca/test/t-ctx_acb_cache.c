@@ -0,0 +1,107 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_acb_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ctx_stats_t stats;
+        ca_t x, y;
+        acb_t a, b, c;
+        slong prec;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        acb_init(a);
+        acb_init(b);
+        acb_init(c);
+
+        ca_ctx_set_option(ctx, CA_OPT_ACB_CACHE_SIZE, 1 + n_randint(state, 4));
+
+        ca_randtest(x, state, 3, 5, ctx);
+        ca_randtest(y, state, 3, 5, ctx);
+        prec = 2 + n_randint(state, 200);
+
+        ca_get_acb_raw(a, x, prec, ctx);
+        ca_get_acb_raw(c, y, prec, ctx);
+        ca_get_acb_raw(b, x, prec / 2 + 1, ctx);
+
+        if (!acb_overlaps(a, b))
+        {
+            flint_printf("FAIL: overlap (memo)\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("a = "); acb_printn(a, 30, 0); flint_printf("\n");
+            flint_printf("b = "); acb_printn(b, 30, 0); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_ctx_set_option(ctx, CA_OPT_ACB_CACHE_SIZE, 0);
+        ca_get_acb_raw(b, x, prec, ctx);
+
+        if (!acb_overlaps(a, b))
+        {
+            flint_printf("FAIL: overlap (no memo)\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("a = "); acb_printn(a, 30, 0); flint_printf("\n");
+            flint_printf("b = "); acb_printn(b, 30, 0); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* a single-entry memo is hit by repeating the last query */
+        ca_ctx_set_option(ctx, CA_OPT_ACB_CACHE_SIZE, 1);
+        ca_ctx_stats_reset(ctx);
+        ca_get_acb_raw(a, y, prec, ctx);
+        ca_get_acb_raw(b, y, prec, ctx);
+        ca_ctx_stats_get(stats, ctx);
+
+        if (!acb_overlaps(a, b) || !acb_overlaps(a, c) ||
+            (stats->acb_cache_misses != 0 && stats->acb_cache_hits != 1))
+        {
+            flint_printf("FAIL: repeated query\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        ca_ctx_cache_sweep(ctx);
+        ca_get_acb_raw(b, y, prec, ctx);
+
+        if (!acb_overlaps(a, b))
+        {
+            flint_printf("FAIL: after sweep\n");
+            flint_abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(c);
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_budget....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y;
+        truth_t t1, t2;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+
+        /* an exhausted budget gives up immediately */
+        ca_ctx_set_option(ctx, CA_OPT_WORK_LIMIT, 1);
+        ca_ctx_budget_start(ctx);
+        _ca_ctx_budget_charge(ctx, 2);
+        ca_pi(x, ctx);
+        ca_sub_ui(x, x, 3, ctx);
+
+        if (!ca_ctx_budget_exceeded(ctx) || ca_check_is_zero(x, ctx) != T_UNKNOWN)
+        {
+            flint_printf("FAIL: exhausted budget\n");
+            flint_abort();
+        }
+
+        ca_ctx_budget_start(ctx);
+
+        if (ca_ctx_budget_exceeded(ctx) || ca_check_is_zero(x, ctx) != T_FALSE)
+        {
+            flint_printf("FAIL: budget_start\n");
+            flint_abort();
+        }
+
+        /* a field built after the budget ran out is completed once
+           there is budget again */
+        ca_ctx_set_option(ctx, CA_OPT_WORK_LIMIT, 1);
+        ca_ctx_budget_start(ctx);
+        _ca_ctx_budget_charge(ctx, 2);
+        ca_set_ui(x, 4, ctx);
+        ca_log(x, x, ctx);
+        ca_set_ui(y, 2, ctx);
+        ca_log(y, y, ctx);
+        ca_mul_ui(y, y, 2, ctx);
+        ca_sub(x, x, y, ctx);
+
+        ca_ctx_set_option(ctx, CA_OPT_WORK_LIMIT, 0);
+        ca_ctx_budget_start(ctx);
+        ca_set_ui(x, 4, ctx);
+        ca_log(x, x, ctx);
+        ca_set_ui(y, 2, ctx);
+        ca_log(y, y, ctx);
+        ca_mul_ui(y, y, 2, ctx);
+        ca_sub(x, x, y, ctx);
+
+        if (ca_check_is_zero(x, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL: field built without budget\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* a limited budget gives consistent answers */
+        ca_ctx_set_option(ctx, CA_OPT_WORK_LIMIT, n_randint(state, 20));
+        ca_ctx_budget_start(ctx);
+
+        ca_randtest(x, state, 5, 5, ctx);
+        ca_randtest(y, state, 5, 5, ctx);
+        ca_mul(x, x, y, ctx);
+        ca_sub(x, x, y, ctx);
+        t1 = ca_check_is_zero(x, ctx);
+
+        ca_ctx_set_option(ctx, CA_OPT_WORK_LIMIT, 0);
+        ca_ctx_budget_start(ctx);
+        t2 = ca_check_is_zero(x, ctx);
+
+        if (t1 != T_UNKNOWN && t1 != t2)
+        {
+            flint_printf("FAIL: consistency\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("t1 = "); truth_print(t1); flint_printf("\n");
+            flint_printf("t2 = "); truth_print(t2); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_cache_sweep....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y, z, a, b;
+        slong i, reps;
+
+        ca_ctx_init(ctx);
+
+        /* tiny memory limit: sweep as often as possible */
+        if (n_randint(state, 2))
+            ctx->options[CA_OPT_CACHE_MEM_LIMIT] = 1;
+
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(a, ctx);
+        ca_init(b, ctx);
+
+        reps = 1 + n_randint(state, 5);
+        for (i = 0; i < reps; i++)
+        {
+            ca_randtest(x, state, 3, 5, ctx);
+            ca_randtest(y, state, 3, 5, ctx);
+            ca_randtest(z, state, 3, 5, ctx);
+
+            /* x (y + z) = x y + x z */
+            ca_add(a, y, z, ctx);
+            ca_mul(a, a, x, ctx);
+            ca_mul(b, x, y, ctx);
+            ca_mul(z, x, z, ctx);
+            ca_add(b, b, z, ctx);
+
+            if (n_randint(state, 2))
+            {
+                ca_zero(x, ctx);
+                ca_zero(y, ctx);
+                ca_zero(z, ctx);
+                ca_ctx_cache_sweep(ctx);
+            }
+
+            if (ca_check_equal(a, b, ctx) == T_FALSE)
+            {
+                flint_printf("FAIL: x (y + z) != x y + x z\n");
+                flint_printf("a = "); ca_print(a, ctx); flint_printf("\n\n");
+                flint_printf("b = "); ca_print(b, ctx); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        ca_zero(x, ctx);
+        ca_zero(y, ctx);
+        ca_zero(z, ctx);
+        ca_zero(a, ctx);
+        ca_zero(b, ctx);
+
+        ca_ctx_cache_sweep(ctx);
+
+        /* only QQ and QQ(i) should remain */
+        if (CA_CTX_FIELD_CACHE(ctx)->length != 2 || CA_CTX_EXT_CACHE(ctx)->length != 1)
+        {
+            flint_printf("FAIL: cache not emptied\n");
+            flint_printf("fields = %wd, ext = %wd\n", CA_CTX_FIELD_CACHE(ctx)->length, CA_CTX_EXT_CACHE(ctx)->length);
+            ca_ctx_print(ctx);
+            flint_abort();
+        }
+
+        if (ca_ctx_cache_allocated_bytes(ctx) <= 0)
+        {
+            flint_printf("FAIL: allocated bytes\n");
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(a, ctx);
+        ca_clear(b, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_cache_write....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx, ctx2;
+        ca_t x, y, z, u, v;
+        calcium_stream_t out;
+        slong i;
+
+        ca_ctx_init(ctx);
+        ca_ctx_init(ctx2);
+
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(u, ctx2);
+        ca_init(v, ctx2);
+
+        ca_randtest(x, state, 5, 5, ctx);
+        ca_randtest(y, state, 5, 5, ctx);
+        ca_mul(z, x, y, ctx);
+
+        calcium_stream_init_str(out);
+        ca_ctx_cache_write(out, ctx);
+
+        if (!ca_ctx_cache_read(ctx2, out->s, out->len))
+        {
+            flint_printf("FAIL: read\n\n%s\n", out->s);
+            flint_abort();
+        }
+
+        if (CA_CTX_FIELD_CACHE(ctx2)->length != CA_CTX_FIELD_CACHE(ctx)->length ||
+            CA_CTX_EXT_CACHE(ctx2)->length != CA_CTX_EXT_CACHE(ctx)->length)
+        {
+            flint_printf("FAIL: cache size\n\n%s\n", out->s);
+            ca_ctx_print(ctx);
+            ca_ctx_print(ctx2);
+            flint_abort();
+        }
+
+        ca_transfer(u, ctx2, x, ctx);
+        ca_transfer(v, ctx2, y, ctx);
+        ca_mul(u, u, v, ctx2);
+        ca_transfer(v, ctx2, z, ctx);
+
+        if (ca_check_equal(u, v, ctx2) == T_FALSE)
+        {
+            flint_printf("FAIL: x * y\n\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n\n");
+            flint_printf("u = "); ca_print(u, ctx2); flint_printf("\n\n");
+            flint_printf("v = "); ca_print(v, ctx2); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* a damaged snapshot must be rejected */
+        i = n_randint(state, out->len);
+        out->s[i] = (out->s[i] == '1') ? '2' : '1';
+
+        if (ca_ctx_cache_read(ctx2, out->s, out->len))
+        {
+            flint_printf("FAIL: accepted damaged snapshot\n\n%s\n", out->s);
+            flint_abort();
+        }
+
+        flint_free(out->s);
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(u, ctx2);
+        ca_clear(v, ctx2);
+        ca_ctx_clear(ctx);
+        ca_ctx_clear(ctx2);
+    }
+
+    /* relations are rebuilt when loading */
+    {
+        ca_ctx_t ctx, ctx2;
+        ca_t x, y, u, v;
+        calcium_stream_t out;
+
+        ca_ctx_init(ctx);
+        ca_ctx_init(ctx2);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(u, ctx2);
+        ca_init(v, ctx2);
+
+        ca_set_ui(x, 2, ctx);
+        ca_log(x, x, ctx);
+        ca_set_ui(y, 4, ctx);
+        ca_log(y, y, ctx);
+        ca_add(y, y, x, ctx);
+        ca_sub(y, y, x, ctx);
+
+        calcium_stream_init_str(out);
+        ca_ctx_cache_write(out, ctx);
+
+        if (!ca_ctx_cache_read(ctx2, out->s, out->len))
+        {
+            flint_printf("FAIL: read (log)\n\n%s\n", out->s);
+            flint_abort();
+        }
+
+        /* log(4) - 2 log(2) = 0 */
+        ca_transfer(u, ctx2, x, ctx);
+        ca_transfer(v, ctx2, y, ctx);
+        ca_mul_ui(u, u, 2, ctx2);
+        ca_sub(u, v, u, ctx2);
+
+        if (ca_check_is_zero(u, ctx2) != T_TRUE)
+        {
+            flint_printf("FAIL: log relation\n\n");
+            flint_printf("u = "); ca_print(u, ctx2); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        flint_free(out->s);
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(u, ctx2);
+        ca_clear(v, ctx2);
+        ca_ctx_clear(ctx);
+        ca_ctx_clear(ctx2);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
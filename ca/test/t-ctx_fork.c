@@ -0,0 +1,173 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_fork....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 300 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx, fork1, fork2, ctx3;
+        ca_t x, y, w, t, u, v;
+
+        ca_ctx_init(ctx);
+        ca_ctx_init(ctx3);
+
+        ca_init(x, ctx);
+        ca_randtest(x, state, 5, 5, ctx);
+
+        ca_ctx_fork(fork1, ctx);
+        ca_ctx_fork(fork2, fork1);
+
+        ca_init(y, fork2);
+        ca_init(w, fork2);
+        ca_init(t, fork2);
+        ca_init(u, ctx3);
+        ca_init(v, ctx3);
+
+        ca_randtest(w, state, 5, 5, fork2);
+        ca_transfer(t, fork2, x, ctx);
+        ca_add(y, t, w, fork2);
+        ca_sub(t, y, w, fork2);
+
+        if (ca_check_equal(t, x, fork2) == T_FALSE)
+        {
+            flint_printf("FAIL: (x + w) - w\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("w = "); ca_print(w, fork2); flint_printf("\n\n");
+            flint_printf("t = "); ca_print(t, fork2); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_transfer(u, ctx3, t, fork2);
+        ca_transfer(v, ctx3, x, ctx);
+
+        if (ca_check_equal(u, v, ctx3) == T_FALSE)
+        {
+            flint_printf("FAIL: transfer\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("u = "); ca_print(u, ctx3); flint_printf("\n\n");
+            flint_printf("v = "); ca_print(v, ctx3); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_clear(y, fork2);
+        ca_clear(w, fork2);
+        ca_clear(t, fork2);
+        ca_ctx_clear(fork2);
+        ca_ctx_clear(fork1);
+
+        /* the parent can be modified again */
+        ca_init(t, ctx);
+        ca_randtest(t, state, 5, 5, ctx);
+        ca_mul(t, t, x, ctx);
+        ca_ctx_cache_sweep(ctx);
+
+        ca_transfer(u, ctx3, t, ctx);
+
+        ca_clear(t, ctx);
+        ca_clear(x, ctx);
+        ca_clear(u, ctx3);
+        ca_clear(v, ctx3);
+        ca_ctx_clear(ctx);
+        ca_ctx_clear(ctx3);
+    }
+
+    /* the parent can create new fields while it has live forks, and
+       sibling forks do not share the fields they create */
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx, fork1, fork2;
+        ca_t x, y, s, t, u, v;
+        slong n;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+
+        ca_pi(x, ctx);
+
+        ca_ctx_fork(fork1, ctx);
+        ca_ctx_fork(fork2, ctx);
+
+        /* new extension numbers and fields in the parent */
+        n = 2 + n_randint(state, 1000);
+        ca_sqrt_ui(y, n, ctx);
+        ca_add(y, y, x, ctx);
+        ca_init(s, ctx);
+        ca_euler(s, ctx);
+        ca_mul(y, y, s, ctx);
+        ca_clear(s, ctx);
+
+        ca_init(s, fork1);
+        ca_init(t, fork1);
+        ca_init(u, fork2);
+        ca_init(v, fork2);
+
+        /* visible in both forks */
+        ca_transfer(s, fork1, y, ctx);
+        ca_transfer(u, fork2, y, ctx);
+
+        if (!CA_IS_SPECIAL(s) && CA_FIELD(s, fork1) != CA_FIELD(y, ctx))
+        {
+            flint_printf("FAIL: shared parent field\n");
+            flint_abort();
+        }
+
+        /* a field created in fork1 is owned by fork1 only */
+        ca_log(t, s, fork1);
+        ca_add(t, t, s, fork1);
+        ca_transfer(v, fork2, t, fork1);
+
+        if (!CA_IS_SPECIAL(t) && !CA_CTX_OWNS(CA_FIELD(t, fork1), fork1))
+        {
+            flint_printf("FAIL: ownership\n");
+            flint_abort();
+        }
+
+        ca_clear(s, fork1);
+        ca_clear(t, fork1);
+        ca_ctx_clear(fork1);
+
+        /* the copy in fork2 must survive clearing fork1 */
+        ca_sub(v, v, u, fork2);
+        ca_exp(v, v, fork2);
+
+        if (ca_check_equal(v, u, fork2) == T_FALSE)
+        {
+            flint_printf("FAIL: sibling transfer\n");
+            flint_printf("u = "); ca_print(u, fork2); flint_printf("\n\n");
+            flint_printf("v = "); ca_print(v, fork2); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_clear(u, fork2);
+        ca_clear(v, fork2);
+        ca_ctx_clear(fork2);
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_op_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ctx_stats_t stats;
+        ca_t x, y, z, w;
+        int op;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(w, ctx);
+
+        ca_ctx_set_option(ctx, CA_OPT_OP_CACHE_SIZE, 1 + n_randint(state, 8));
+
+        ca_randtest(x, state, 3, 5, ctx);
+        ca_randtest(y, state, 3, 5, ctx);
+        op = n_randint(state, 7);
+
+        switch (op)
+        {
+            case 0: ca_add(z, x, y, ctx); break;
+            case 1: ca_mul(z, x, y, ctx); break;
+            case 2: ca_div(z, x, y, ctx); break;
+            case 3: ca_pow(z, x, y, ctx); break;
+            case 4: ca_exp(z, x, ctx); break;
+            case 5: ca_log(z, x, ctx); break;
+            default: ca_sqrt(z, x, ctx); break;
+        }
+
+        ca_ctx_stats_reset(ctx);
+
+        /* the second evaluation must give the same representation,
+           with aliasing between the output and an input */
+        ca_set(w, x, ctx);
+
+        switch (op)
+        {
+            case 0: ca_add(w, w, y, ctx); break;
+            case 1: ca_mul(w, w, y, ctx); break;
+            case 2: ca_div(w, w, y, ctx); break;
+            case 3: ca_pow(w, w, y, ctx); break;
+            case 4: ca_exp(w, w, ctx); break;
+            case 5: ca_log(w, w, ctx); break;
+            default: ca_sqrt(w, w, ctx); break;
+        }
+
+        ca_ctx_stats_get(stats, ctx);
+
+        if (!ca_equal_repr(z, w, ctx) || (stats->op_cache_misses != 0 && stats->op_cache_hits == 0))
+        {
+            flint_printf("FAIL: repeated operation %d\n", op);
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n");
+            flint_printf("w = "); ca_print(w, ctx); flint_printf("\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        /* changing an option must flush the memo */
+        ca_ctx_set_option(ctx, CA_OPT_PREC_LIMIT, ca_ctx_get_option(ctx, CA_OPT_PREC_LIMIT) + 1);
+        ca_ctx_stats_reset(ctx);
+
+        switch (op)
+        {
+            case 0: ca_add(w, x, y, ctx); break;
+            case 1: ca_mul(w, x, y, ctx); break;
+            case 2: ca_div(w, x, y, ctx); break;
+            case 3: ca_pow(w, x, y, ctx); break;
+            case 4: ca_exp(w, x, ctx); break;
+            case 5: ca_log(w, x, ctx); break;
+            default: ca_sqrt(w, x, ctx); break;
+        }
+
+        ca_ctx_stats_get(stats, ctx);
+
+        if (stats->op_cache_hits != 0 && stats->op_cache_misses == 0)
+        {
+            flint_printf("FAIL: memo not flushed after option change %d\n", op);
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        /* compare with the uncached result */
+        ca_ctx_set_option(ctx, CA_OPT_OP_CACHE_SIZE, 0);
+
+        switch (op)
+        {
+            case 0: ca_add(w, x, y, ctx); break;
+            case 1: ca_mul(w, x, y, ctx); break;
+            case 2: ca_div(w, x, y, ctx); break;
+            case 3: ca_pow(w, x, y, ctx); break;
+            case 4: ca_exp(w, x, ctx); break;
+            case 5: ca_log(w, x, ctx); break;
+            default: ca_sqrt(w, x, ctx); break;
+        }
+
+        if (ca_check_equal(z, w, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: uncached operation %d\n", op);
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n");
+            flint_printf("w = "); ca_print(w, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(w, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ctx_stats....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ctx_stats_t s1, s2;
+        ca_t x, y;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+
+        ca_ctx_stats_get(s1, ctx);
+
+        /* QQ and QQ(i) were built by the constructor */
+        if (s1->field_cache_misses != 2 || s1->ext_cache_misses != 1)
+        {
+            flint_printf("FAIL: initial counters\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        ca_randtest(x, state, 5, 5, ctx);
+        ca_randtest(y, state, 5, 5, ctx);
+        ca_mul(x, x, y, ctx);
+        ca_check_is_zero(x, ctx);
+
+        ca_ctx_stats_get(s2, ctx);
+
+        if (s2->field_cache_misses != CA_CTX_FIELD_CACHE(ctx)->length ||
+            s2->ext_cache_misses != CA_CTX_EXT_CACHE(ctx)->length ||
+            s2->field_cache_hits < s1->field_cache_hits ||
+            s2->is_zero_prec_steps < s2->is_zero_numerical)
+        {
+            flint_printf("FAIL: counters\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        ca_ctx_stats_reset(ctx);
+        ca_ctx_stats_get(s2, ctx);
+
+        if (s2->field_cache_misses != 0 || s2->qqbar.composed_ops != 0)
+        {
+            flint_printf("FAIL: reset\n");
+            ca_ctx_stats_print(ctx);
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+
+/* mode 0: rationals, 1: the number field of a, 2: mixed fields,
+   3: mixed fields and special values */
+static void
+ca_randtest_dot_entry(ca_t res, flint_rand_t state, int mode, const ca_t a, ca_ctx_t ctx)
+{
+    if (mode == 0)
+        ca_randtest_rational(res, state, 10, ctx);
+    else if (mode == 1)
+        ca_randtest_same_nf(res, state, a, 10, 5, ctx);
+    else if (mode == 3 && n_randint(state, 4) == 0)
+        ca_randtest_special(res, state, 2, 10, ctx);
+    else
+        ca_randtest(res, state, 2, 10, ctx);
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("dot....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* ca_dot */
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ptr x, y;
+        ca_t a, s, t, res, initial;
+        slong i, len, xstep, ystep;
+        int mode, subtract, have_initial, alias;
+
+        ca_ctx_init(ctx);
+        ca_init(a, ctx);
+        ca_init(s, ctx);
+        ca_init(t, ctx);
+        ca_init(res, ctx);
+        ca_init(initial, ctx);
+
+        mode = n_randint(state, 4);
+        len = n_randint(state, 6);
+        xstep = 1 + n_randint(state, 2);
+        ystep = 1 + n_randint(state, 2);
+        subtract = n_randint(state, 2);
+        have_initial = n_randint(state, 2);
+        alias = have_initial && n_randint(state, 2);
+
+        switch (n_randint(state, 3))
+        {
+            case 0:
+                ca_i(a, ctx);
+                break;
+            case 1:
+                ca_sqrt_ui(a, 2, ctx);
+                break;
+            default:
+                ca_sqrt_ui(a, 3, ctx);
+        }
+
+        x = _ca_vec_init(len * xstep, ctx);
+        y = _ca_vec_init(len * ystep, ctx);
+
+        for (i = 0; i < len * xstep; i++)
+            ca_randtest_dot_entry(x + i, state, mode, a, ctx);
+        for (i = 0; i < len * ystep; i++)
+            ca_randtest_dot_entry(y + i, state, mode, a, ctx);
+
+        if (have_initial)
+            ca_randtest_dot_entry(initial, state, mode, a, ctx);
+
+        ca_randtest_special(res, state, 2, 10, ctx);
+
+        if (alias)
+        {
+            ca_set(res, initial, ctx);
+            ca_dot(res, res, subtract, x, xstep, y, ystep, len, ctx);
+        }
+        else
+        {
+            ca_dot(res, have_initial ? initial : NULL, subtract, x, xstep, y, ystep, len, ctx);
+        }
+
+        ca_zero(s, ctx);
+        for (i = 0; i < len; i++)
+        {
+            ca_mul(t, x + i * xstep, y + i * ystep, ctx);
+            ca_add(s, s, t, ctx);
+        }
+
+        if (subtract)
+            ca_neg(s, s, ctx);
+
+        if (have_initial)
+            ca_add(s, initial, s, ctx);
+
+        if (ca_check_equal(res, s, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: ca_dot\n\n");
+            flint_printf("mode = %d, len = %wd, subtract = %d, initial = %d, alias = %d\n\n",
+                mode, len, subtract, have_initial, alias);
+            for (i = 0; i < len; i++)
+            {
+                flint_printf("x[%wd] = ", i); ca_print(x + i * xstep, ctx); flint_printf("\n");
+                flint_printf("y[%wd] = ", i); ca_print(y + i * ystep, ctx); flint_printf("\n");
+            }
+            flint_printf("\ninitial = "); ca_print(initial, ctx); flint_printf("\n\n");
+            flint_printf("res = "); ca_print(res, ctx); flint_printf("\n\n");
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        _ca_vec_clear(x, len * xstep, ctx);
+        _ca_vec_clear(y, len * ystep, ctx);
+        ca_clear(a, ctx);
+        ca_clear(s, ctx);
+        ca_clear(t, ctx);
+        ca_clear(res, ctx);
+        ca_clear(initial, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    /* ca_addmul, ca_submul */
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t a, x, y, z, res, s;
+        int mode, subtract, alias;
+
+        ca_ctx_init(ctx);
+        ca_init(a, ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(z, ctx);
+        ca_init(res, ctx);
+        ca_init(s, ctx);
+
+        mode = n_randint(state, 4);
+        subtract = n_randint(state, 2);
+        alias = n_randint(state, 4);
+
+        ca_sqrt_ui(a, 2 + n_randint(state, 2), ctx);
+        ca_randtest_dot_entry(x, state, mode, a, ctx);
+        ca_randtest_dot_entry(y, state, mode, a, ctx);
+        ca_randtest_dot_entry(z, state, mode, a, ctx);
+
+        /* res = z + x*y, res = x + x*y, res = y + x*y or res = x + x*x */
+        switch (alias)
+        {
+            case 0:
+                ca_set(res, z, ctx);
+                if (subtract)
+                    ca_submul(res, x, y, ctx);
+                else
+                    ca_addmul(res, x, y, ctx);
+                ca_mul(s, x, y, ctx);
+                break;
+            case 1:
+                ca_set(z, x, ctx);
+                ca_set(res, x, ctx);
+                if (subtract)
+                    ca_submul(res, res, y, ctx);
+                else
+                    ca_addmul(res, res, y, ctx);
+                ca_mul(s, x, y, ctx);
+                break;
+            case 2:
+                ca_set(z, y, ctx);
+                ca_set(res, y, ctx);
+                if (subtract)
+                    ca_submul(res, x, res, ctx);
+                else
+                    ca_addmul(res, x, res, ctx);
+                ca_mul(s, x, y, ctx);
+                break;
+            default:
+                ca_set(z, x, ctx);
+                ca_set(res, x, ctx);
+                if (subtract)
+                    ca_submul(res, res, res, ctx);
+                else
+                    ca_addmul(res, res, res, ctx);
+                ca_mul(s, x, x, ctx);
+        }
+
+        if (subtract)
+            ca_sub(s, z, s, ctx);
+        else
+            ca_add(s, z, s, ctx);
+
+        if (ca_check_equal(res, s, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: ca_addmul / ca_submul\n\n");
+            flint_printf("mode = %d, subtract = %d, alias = %d\n\n", mode, subtract, alias);
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n\n");
+            flint_printf("res = "); ca_print(res, ctx); flint_printf("\n\n");
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_clear(a, ctx);
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(z, ctx);
+        ca_clear(res, ctx);
+        ca_clear(s, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("is_cyclotomic_nf_elem....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y;
+        qqbar_t a, b;
+        fmpq_poly_t poly;
+        slong p, p2;
+        ulong q, q2;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        qqbar_init(a);
+        qqbar_init(b);
+        fmpq_poly_init(poly);
+
+        q = 1 + n_randint(state, 30);
+        p = n_randint(state, q);
+
+        /* x = f(zeta) */
+        qqbar_root_of_unity(a, p, q);
+        fmpq_poly_randtest(poly, state, 1 + n_randint(state, 20), 1 + n_randint(state, 20));
+        ca_set_qqbar(x, a, ctx);
+        ca_fmpq_poly_evaluate(x, poly, x, ctx);
+
+        if (ca_is_cyclotomic_nf_elem(&p2, &q2, x, ctx))
+        {
+            qqbar_root_of_unity(a, p2, q2);
+
+            if (!qqbar_equal(a, CA_FIELD_NF_QQBAR(CA_FIELD(x, ctx))))
+            {
+                flint_printf("FAIL (root of unity)\n\n");
+                flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+                flint_printf("p2 = %wd, q2 = %wu\n\n", p2, q2);
+                flint_abort();
+            }
+        }
+
+        /* conjugation, which uses a Galois automorphism in cyclotomic fields */
+        ca_conj_deep(y, x, ctx);
+        qqbar_root_of_unity(b, -p, q);
+        ca_set_qqbar(x, b, ctx);
+        ca_fmpq_poly_evaluate(x, poly, x, ctx);
+
+        if (ca_check_equal(x, y, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL (conj)\n\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        qqbar_clear(a);
+        qqbar_clear(b);
+        fmpq_poly_clear(poly);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("merge_fields....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_t x, y, a, b, c, d;
+        ca_struct v[3];
+        ca_struct w[3];
+        slong i;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(a, ctx);
+        ca_init(b, ctx);
+        ca_init(c, ctx);
+        ca_init(d, ctx);
+
+        ca_randtest(x, state, 2, 5, ctx);
+        ca_randtest(y, state, 2, 5, ctx);
+
+        if (!CA_IS_SPECIAL(x) && !CA_IS_SPECIAL(y))
+        {
+            ca_ctx_set_option(ctx, CA_OPT_MERGE_CACHE_SIZE, 0);
+            ca_merge_fields(a, b, x, y, ctx);
+
+            /* the second merge with the same fields hits the memo,
+               also with the operands swapped */
+            ca_ctx_set_option(ctx, CA_OPT_MERGE_CACHE_SIZE, 1 + n_randint(state, 4));
+            ca_merge_fields(c, d, x, y, ctx);
+            ca_merge_fields(d, c, y, x, ctx);
+
+            if (!ca_equal_repr(a, c, ctx) || !ca_equal_repr(b, d, ctx))
+            {
+                flint_printf("FAIL: memoized merge\n");
+                flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+                flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+                flint_printf("a = "); ca_print(a, ctx); flint_printf("\n");
+                flint_printf("b = "); ca_print(b, ctx); flint_printf("\n");
+                flint_printf("c = "); ca_print(c, ctx); flint_printf("\n");
+                flint_printf("d = "); ca_print(d, ctx); flint_printf("\n");
+                flint_abort();
+            }
+        }
+
+        for (i = 0; i < 3; i++)
+        {
+            ca_init(v + i, ctx);
+            ca_init(w + i, ctx);
+
+            do {
+                ca_randtest(v + i, state, 2, 5, ctx);
+            } while (CA_IS_SPECIAL(v + i));
+
+            ca_set(w + i, v + i, ctx);
+        }
+
+        ca_merge_fields_vec(w, w, 3, ctx);
+
+        for (i = 0; i < 3; i++)
+        {
+            if (CA_FIELD(w + i, ctx) != CA_FIELD(w, ctx) || ca_check_equal(v + i, w + i, ctx) == T_FALSE)
+            {
+                flint_printf("FAIL: merge_fields_vec\n");
+                flint_printf("v = "); ca_print(v + i, ctx); flint_printf("\n");
+                flint_printf("w = "); ca_print(w + i, ctx); flint_printf("\n");
+                flint_abort();
+            }
+        }
+
+        for (i = 0; i < 3; i++)
+        {
+            ca_clear(v + i, ctx);
+            ca_clear(w + i, ctx);
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(a, ctx);
+        ca_clear(b, ctx);
+        ca_clear(c, ctx);
+        ca_clear(d, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_mat.h"
+
+#if FLINT_USES_PTHREAD
+
+/* One thread multiplies matrices (which opens reduction batches
+   internally) while the other adds on the same context; the batch
+   of the first thread must not leave the sums of the second
+   thread unreduced. */
+typedef struct
+{
+    ca_ctx_struct * ctx;
+    slong seed;
+    int matrices;
+}
+worker_arg_t;
+
+static void
+check_reduced(const ca_t x, const char * what, ca_ctx_t ctx)
+{
+    ca_t t;
+
+    ca_init(t, ctx);
+    ca_set(t, x, ctx);
+    ca_reduce(t, ctx);
+
+    if (!ca_equal_repr(t, x, ctx))
+    {
+        flint_printf("FAIL: unreduced %s\n", what);
+        flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+        flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+        flint_abort();
+    }
+
+    ca_clear(t, ctx);
+}
+
+static void *
+worker(void * arg_ptr)
+{
+    worker_arg_t * arg = (worker_arg_t *) arg_ptr;
+    ca_ctx_struct * ctx = arg->ctx;
+    flint_rand_t state;
+    slong iter, i, j;
+
+    flint_randinit(state);
+    flint_randseed(state, arg->seed, arg->seed + 1);
+
+    for (iter = 0; iter < 10; iter++)
+    {
+        if (arg->matrices)
+        {
+            ca_mat_t A, B, C;
+
+            ca_mat_init(A, 3, 3, ctx);
+            ca_mat_init(B, 3, 3, ctx);
+            ca_mat_init(C, 3, 3, ctx);
+
+            ca_mat_randtest(A, state, 2, 5, ctx);
+            ca_mat_randtest(B, state, 2, 5, ctx);
+            ca_mat_mul(C, A, B, ctx);
+
+            for (i = 0; i < 3; i++)
+                for (j = 0; j < 3; j++)
+                    check_reduced(ca_mat_entry(C, i, j), "matrix entry", ctx);
+
+            ca_mat_clear(A, ctx);
+            ca_mat_clear(B, ctx);
+            ca_mat_clear(C, ctx);
+        }
+        else
+        {
+            ca_t x, y, z;
+
+            ca_init(x, ctx);
+            ca_init(y, ctx);
+            ca_init(z, ctx);
+
+            for (i = 0; i < 10; i++)
+            {
+                ca_randtest(x, state, 2, 5, ctx);
+                ca_randtest(y, state, 2, 5, ctx);
+                ca_add(z, x, y, ctx);
+                ca_mul(z, z, y, ctx);
+                check_reduced(z, "sum", ctx);
+            }
+
+            ca_clear(x, ctx);
+            ca_clear(y, ctx);
+            ca_clear(z, ctx);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+
+    return NULL;
+}
+
+#endif
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("reduction_batch....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ptr x;
+        ca_t s, t, u;
+        slong i, len;
+
+        ca_ctx_init(ctx);
+
+        len = 1 + n_randint(state, 5);
+        x = flint_malloc(sizeof(ca_struct) * len);
+        for (i = 0; i < len; i++)
+        {
+            ca_init(x + i, ctx);
+            ca_randtest(x + i, state, 2, 5, ctx);
+        }
+
+        ca_init(s, ctx);
+        ca_init(t, ctx);
+        ca_init(u, ctx);
+
+        ca_ctx_set_option(ctx, CA_OPT_REDUCTION_BATCH_LENGTH, n_randint(state, 2) ? 200 : n_randint(state, 10));
+
+        /* s = x[0] * x[1] + ... computed eagerly */
+        ca_one(s, ctx);
+        for (i = 0; i < len; i++)
+        {
+            ca_mul(t, x + i, x + (len - 1 - i), ctx);
+            ca_add(s, s, t, ctx);
+        }
+
+        ca_ctx_begin_reduction_batch(ctx);
+
+        ca_one(u, ctx);
+        for (i = 0; i < len; i++)
+        {
+            ca_mul(t, x + i, x + (len - 1 - i), ctx);
+            ca_add(u, u, t, ctx);
+        }
+
+        /* zero tests must see through unreduced values */
+        ca_sub(t, u, s, ctx);
+
+        if (ca_check_is_zero(t, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: zero test inside batch\n");
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n");
+            flint_printf("u = "); ca_print(u, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_reduce(u, ctx);
+        ca_ctx_end_reduction_batch(ctx);
+
+        if (ca_check_equal(s, u, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL\n");
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n");
+            flint_printf("u = "); ca_print(u, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < len; i++)
+            ca_clear(x + i, ctx);
+        flint_free(x);
+
+        ca_clear(s, ctx);
+        ca_clear(t, ctx);
+        ca_clear(u, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+#if FLINT_USES_PTHREAD
+    for (iter = 0; iter < 10 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        pthread_t threads[2];
+        worker_arg_t args[2];
+        slong i;
+
+        ca_ctx_init(ctx);
+        ctx->options[CA_OPT_THREAD_SAFE] = 1;
+
+        for (i = 0; i < 2; i++)
+        {
+            args[i].ctx = ctx;
+            args[i].seed = 1 + 2 * iter + i;
+            args[i].matrices = (i == 0);
+            pthread_create(threads + i, NULL, worker, args + i);
+        }
+
+        for (i = 0; i < 2; i++)
+            pthread_join(threads[i], NULL);
+
+        ca_ctx_clear(ctx);
+    }
+#endif
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+
+#define NUM_THREADS 4
+
+#if FLINT_USES_PTHREAD
+
+typedef struct
+{
+    ca_ctx_struct * ctx;
+    slong seed;
+    slong iters;
+}
+worker_arg_t;
+
+static void *
+worker(void * arg_ptr)
+{
+    worker_arg_t * arg = (worker_arg_t *) arg_ptr;
+    ca_ctx_struct * ctx = arg->ctx;
+    flint_rand_t state;
+    ca_t x, y, a, b;
+    slong iter;
+
+    flint_randinit(state);
+    flint_randseed(state, arg->seed, arg->seed + 1);
+
+    ca_init(x, ctx);
+    ca_init(y, ctx);
+    ca_init(a, ctx);
+    ca_init(b, ctx);
+
+    for (iter = 0; iter < arg->iters; iter++)
+    {
+        ca_randtest(x, state, 3, 5, ctx);
+        ca_randtest(y, state, 3, 5, ctx);
+
+        /* (x + y)^2 = x^2 + 2xy + y^2 */
+        ca_add(a, x, y, ctx);
+        ca_sqr(a, a, ctx);
+        ca_sqr(b, x, ctx);
+        ca_mul(x, x, y, ctx);
+        ca_mul_ui(x, x, 2, ctx);
+        ca_add(b, b, x, ctx);
+        ca_sqr(y, y, ctx);
+        ca_add(b, b, y, ctx);
+
+        if (ca_check_equal(a, b, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL: (x + y)^2 != x^2 + 2xy + y^2\n");
+            flint_printf("a = "); ca_print(a, ctx); flint_printf("\n\n");
+            flint_printf("b = "); ca_print(b, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+    }
+
+    ca_clear(x, ctx);
+    ca_clear(y, ctx);
+    ca_clear(a, ctx);
+    ca_clear(b, ctx);
+
+    flint_randclear(state);
+    flint_cleanup();
+
+    return NULL;
+}
+
+#endif
+
+int main()
+{
+    slong iter;
+
+    flint_printf("thread_safe....");
+    fflush(stdout);
+
+#if FLINT_USES_PTHREAD
+    for (iter = 0; iter < 10 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        pthread_t threads[NUM_THREADS];
+        worker_arg_t args[NUM_THREADS];
+        slong i;
+
+        ca_ctx_init(ctx);
+        ctx->options[CA_OPT_THREAD_SAFE] = 1;
+
+        for (i = 0; i < NUM_THREADS; i++)
+        {
+            args[i].ctx = ctx;
+            args[i].seed = 1 + iter * NUM_THREADS + i;
+            args[i].iters = 20;
+            pthread_create(threads + i, NULL, worker, args + i);
+        }
+
+        for (i = 0; i < NUM_THREADS; i++)
+            pthread_join(threads[i], NULL);
+
+        ca_ctx_clear(ctx);
+    }
+#else
+    (void) iter;
+#endif
+
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
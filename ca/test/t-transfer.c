@@ -10,6 +10,7 @@
 */
 
 #include "ca.h"
+#include "ca_field.h"
 
 int main()
 {
@@ -28,7 +29,13 @@ int main()
         slong i, reps;
 
         ca_ctx_init(ctx);
-        ca_ctx_init(ctx2);
+
+        /* force conversion via expressions for generic fields */
+        if (n_randint(state, 4) == 0)
+            ca_ctx_init_mpoly_ord(ctx2, ORD_DEGLEX);
+        else
+            ca_ctx_init(ctx2);
+
         ca_init(x, ctx);
         ca_init(y, ctx2);
         ca_init(z, ctx);
@@ -69,6 +76,126 @@ int main()
         ca_ctx_clear(ctx2);
     }
 
+    /* structural transfer: reuse and invalidation of the translation
+       table, and fields whose ideals differ between the contexts */
+    {
+        ca_ctx_t ctx, ctx2, ctx3;
+        ca_t x, y, z, a, b;
+        ca_field_srcptr K;
+        ca_ext_struct * ext[2];
+        ca_transfer_table_struct * T;
+        fmpz_mpoly_vec_t ideal;
+        ulong v;
+        slong len;
+
+        ca_ctx_init(ctx);
+        ca_ctx_init(ctx2);
+        ca_ctx_init(ctx3);
+        ca_init(x, ctx);
+        ca_init(z, ctx);
+        ca_init(y, ctx2);
+        ca_init(a, ctx3);
+        ca_init(b, ctx3);
+
+        /* pi + sqrt(2), in a generic field with the relation x^2 - 2 */
+        ca_pi(x, ctx);
+        ca_sqrt_ui(z, 2, ctx);
+        ca_add(x, x, z, ctx);
+        K = CA_FIELD(x, ctx);
+
+        ca_transfer(y, ctx2, x, ctx);
+        T = _ca_ctx_transfer_table(ctx2, ctx);
+        v = _ca_transfer_table_get(T, K);
+        len = T->length;
+
+        if (v == 0 || (v & 1) || (ca_field_srcptr) v != CA_FIELD(y, ctx2) ||
+            CA_FIELD(y, ctx2)->ideal_flags != K->ideal_flags)
+        {
+            flint_printf("FAIL: structural transfer\n");
+            flint_abort();
+        }
+
+        /* the table is reused */
+        ca_transfer(y, ctx2, x, ctx);
+        T = _ca_ctx_transfer_table(ctx2, ctx);
+
+        if (T->length != len || (ca_field_srcptr) _ca_transfer_table_get(T, K) != CA_FIELD(y, ctx2))
+        {
+            flint_printf("FAIL: table reuse\n");
+            flint_abort();
+        }
+
+        /* a sweep of the target invalidates the table */
+        ca_zero(y, ctx2);
+        ca_ctx_cache_sweep(ctx2);
+        T = _ca_ctx_transfer_table(ctx2, ctx);
+
+        if (T->length != 0)
+        {
+            flint_printf("FAIL: table invalidation\n");
+            flint_abort();
+        }
+
+        ca_transfer(y, ctx2, x, ctx);
+        ca_transfer(z, ctx, y, ctx2);
+
+        if (ca_check_equal(x, z, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL: transfer after invalidation\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* the target already has the field, with a different ideal */
+        ca_pi(a, ctx3);
+        ca_sqrt_ui(b, 2, ctx3);
+
+        if (CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, 0)))
+        {
+            ext[0] = CA_FIELD_EXT_ELEM(CA_FIELD(b, ctx3), 0);
+            ext[1] = CA_FIELD_EXT_ELEM(CA_FIELD(a, ctx3), 0);
+        }
+        else
+        {
+            ext[0] = CA_FIELD_EXT_ELEM(CA_FIELD(a, ctx3), 0);
+            ext[1] = CA_FIELD_EXT_ELEM(CA_FIELD(b, ctx3), 0);
+        }
+
+        fmpz_mpoly_vec_init(ideal, 0, CA_MCTX_1(ctx3));
+        ca_field_cache_insert_ext_ideal(CA_CTX_FIELD_CACHE(ctx3), ext, 2, ideal, 0, ctx3);
+        fmpz_mpoly_vec_clear(ideal, CA_MCTX_1(ctx3));
+
+        ca_transfer(a, ctx3, x, ctx);
+        T = _ca_ctx_transfer_table(ctx3, ctx);
+        v = _ca_transfer_table_get(T, K);
+
+        if (!(v & 1))
+        {
+            flint_printf("FAIL: ideal mismatch not detected\n");
+            flint_abort();
+        }
+
+        ca_transfer(z, ctx, a, ctx3);
+
+        if (ca_check_equal(x, z, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL: transfer with different ideal\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(z, ctx);
+        ca_clear(y, ctx2);
+        ca_clear(a, ctx3);
+        ca_clear(b, ctx3);
+        ca_ctx_clear(ctx);
+        ca_ctx_clear(ctx2);
+        ca_ctx_clear(ctx3);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
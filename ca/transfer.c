@@ -10,6 +10,249 @@
 */
 
 #include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+#include "ca_vec.h"
+
+void _ca_ctx_init_mctx(ca_ctx_t ctx, slong len);
+
+static int
+_ca_ctx_is_ancestor(ca_ctx_struct * anc, ca_ctx_struct * ctx)
+{
+    for ( ; ctx != NULL; ctx = ctx->parent)
+        if (ctx == anc)
+            return 1;
+
+    return 0;
+}
+
+/* Within a family of forked contexts, the field of src can be used
+   directly in res_ctx if it is owned by res_ctx or one of its ancestors.
+   The field may have been created in the ancestor after res_ctx was
+   forked, so res_ctx may need more multivariate contexts. */
+static int
+_ca_transfer_shared(ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx)
+{
+    ca_field_srcptr K;
+
+    if (!_ca_ctx_is_ancestor(src_ctx, res_ctx) && !_ca_ctx_is_ancestor(res_ctx, src_ctx))
+        return 0;
+
+    K = CA_FIELD_UNSPECIAL(src, src_ctx);
+
+    if (K == NULL)
+        return 1;
+
+    if (!_ca_ctx_is_ancestor(K->owner, res_ctx))
+        return 0;
+
+    if (CA_FIELD_LENGTH(K) > res_ctx->mctx_len)
+        _ca_ctx_init_mctx(res_ctx, CA_FIELD_LENGTH(K));
+
+    return 1;
+}
+
+static void
+_ca_transfer_fexpr(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx)
+{
+    fexpr_t expr;
+    fexpr_init(expr);
+
+    ca_get_fexpr(expr, src, CA_FEXPR_SERIALIZATION, src_ctx);
+
+    if (!ca_set_fexpr(res, expr, res_ctx))
+    {
+        flint_printf("ca_transfer: failed to recreate from expression!\n");
+        flint_abort();
+    }
+
+    fexpr_clear(expr);
+}
+
+static ca_ext_ptr
+_ca_transfer_ext(ca_ext_srcptr x, ca_ctx_t res_ctx, ca_ctx_t src_ctx, ca_transfer_table_struct * T)
+{
+    ca_ext_ptr res;
+    ca_ext_t tmp;
+
+    res = (ca_ext_ptr) _ca_transfer_table_get(T, x);
+
+    if (res != NULL)
+        return res;
+
+    if (CA_EXT_IS_QQBAR(x))
+    {
+        ca_ext_init_qqbar(tmp, CA_EXT_QQBAR(x), res_ctx);
+    }
+    else
+    {
+        ca_ptr args;
+        slong i, nargs;
+
+        nargs = CA_EXT_FUNC_NARGS(x);
+        args = _ca_vec_init(nargs, res_ctx);
+
+        for (i = 0; i < nargs; i++)
+            _ca_transfer(args + i, res_ctx, CA_EXT_FUNC_ARGS(x) + i, src_ctx, T);
+
+        ca_ext_init_fxn(tmp, CA_EXT_HEAD(x), args, nargs, res_ctx);
+        _ca_vec_clear(args, nargs, res_ctx);
+    }
+
+    res = ca_ext_cache_insert(CA_CTX_EXT_CACHE(res_ctx), tmp, res_ctx);
+    ca_ext_clear(tmp, res_ctx);
+
+    /* Keep any enclosure already computed in the source context. In
+       thread-safe mode, it may be updated concurrently, so we leave it. */
+    if (!CA_EXT_IS_QQBAR(x) && !src_ctx->options[CA_OPT_THREAD_SAFE] &&
+        CA_CTX_OWNS(res, res_ctx) && CA_EXT_FUNC_PREC(x) > CA_EXT_FUNC_PREC(res))
+    {
+        acb_set(CA_EXT_FUNC_ENCLOSURE(res), CA_EXT_FUNC_ENCLOSURE(x));
+        CA_EXT_FUNC_PREC(res) = CA_EXT_FUNC_PREC(x);
+    }
+
+    _ca_transfer_table_set(T, x, (ulong) res);
+
+    return res;
+}
+
+/* Returns the field corresponding to K in res_ctx, with the low bit set
+   if elements of K need to be reduced by the ideal of the new field,
+   or 0 if the representation of K cannot be reused. */
+static ulong
+_ca_transfer_field(ca_field_srcptr K, ca_ctx_t res_ctx, ca_ctx_t src_ctx, ca_transfer_table_struct * T)
+{
+    ca_ext_struct ** ext;
+    ca_field_ptr L;
+    slong i, len;
+    ulong v;
+
+    v = _ca_transfer_table_get(T, K);
+
+    if (v != 0)
+        return v;
+
+    /* polynomials cannot be copied between different monomial orders */
+    if (CA_FIELD_IS_GENERIC(K) &&
+        res_ctx->options[CA_OPT_MPOLY_ORD] != src_ctx->options[CA_OPT_MPOLY_ORD])
+        return 0;
+
+    len = CA_FIELD_LENGTH(K);
+    ext = flint_malloc(sizeof(ca_ext_struct *) * FLINT_MAX(len, 1));
+
+    for (i = 0; i < len; i++)
+        ext[i] = _ca_transfer_ext(CA_FIELD_EXT_ELEM(K, i), res_ctx, src_ctx, T);
+
+    /* the generators must come out in the same order */
+    for (i = 1; i < len; i++)
+    {
+        if (ca_ext_cmp_repr(ext[i - 1], ext[i], res_ctx) <= 0)
+        {
+            flint_free(ext);
+            return 0;
+        }
+    }
+
+    L = ca_field_cache_insert_ext_ideal(CA_CTX_FIELD_CACHE(res_ctx), ext, len,
+        CA_FIELD_IS_GENERIC(K) ? CA_FIELD_IDEAL(K) : NULL, K->ideal_flags, res_ctx);
+    v = (ulong) L;
+
+    /* the field may already have existed with a different ideal */
+    if (CA_FIELD_IS_GENERIC(K))
+    {
+        if (CA_FIELD_IDEAL_LENGTH(L) != CA_FIELD_IDEAL_LENGTH(K))
+        {
+            v |= 1;
+        }
+        else
+        {
+            for (i = 0; i < CA_FIELD_IDEAL_LENGTH(K); i++)
+            {
+                if (!fmpz_mpoly_equal(CA_FIELD_IDEAL_ELEM(L, i), CA_FIELD_IDEAL_ELEM(K, i), CA_FIELD_MCTX(L, res_ctx)))
+                {
+                    v |= 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    flint_free(ext);
+
+    _ca_transfer_table_set(T, K, v);
+
+    return v;
+}
+
+static int
+_ca_transfer_struct(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx, ca_transfer_table_struct * T)
+{
+    ca_field_srcptr K;
+    ca_field_ptr L;
+    ulong v;
+
+    K = CA_FIELD_UNSPECIAL(src, src_ctx);
+
+    v = _ca_transfer_field(K, res_ctx, src_ctx, T);
+
+    if (v == 0)
+        return 0;
+
+    L = (ca_field_ptr) (v & ~UWORD(1));
+
+    _ca_make_field_element(res, L, res_ctx);
+
+    if (CA_FIELD_IS_QQ(L))
+    {
+        fmpq_set(CA_FMPQ(res), CA_FMPQ(src));
+    }
+    else if (CA_FIELD_IS_NF(L))
+    {
+        nf_elem_set(CA_NF_ELEM(res), CA_NF_ELEM(src), CA_FIELD_NF(L));
+    }
+    else
+    {
+        fmpz_mpoly_q_set(CA_MPOLY_Q(res), CA_MPOLY_Q(src), CA_FIELD_MCTX(L, res_ctx));
+
+        if (v & 1)
+            _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), L, res_ctx);
+    }
+
+    if (CA_IS_SIGNED_INF(src))
+        res->field |= CA_INF;
+
+    return 1;
+}
+
+void
+_ca_transfer(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx, ca_transfer_table_struct * T)
+{
+    if (res_ctx == src_ctx || _ca_transfer_shared(res_ctx, src, src_ctx))
+    {
+        ca_set(res, src, res_ctx);
+    }
+    else if (CA_IS_QQ(src, src_ctx))
+    {
+        _ca_make_fmpq(res, res_ctx);
+        fmpq_set(CA_FMPQ(res), CA_FMPQ(src));
+    }
+    else if (CA_IS_UNKNOWN(src))
+    {
+        ca_unknown(res, res_ctx);
+    }
+    else if (CA_IS_UNDEFINED(src))
+    {
+        ca_undefined(res, res_ctx);
+    }
+    else if (CA_IS_UNSIGNED_INF(src))
+    {
+        ca_uinf(res, res_ctx);
+    }
+    else if (!_ca_transfer_struct(res, res_ctx, src, src_ctx, T))
+    {
+        _ca_transfer_fexpr(res, res_ctx, src, src_ctx);
+    }
+}
 
 void
 ca_transfer(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx)
@@ -25,19 +268,17 @@ ca_transfer(ca_t res, ca_ctx_t res_ctx, const ca_t src, ca_ctx_t src_ctx)
     }
     else
     {
-        fexpr_t expr;
-        fexpr_init(expr);
+        ca_transfer_table_struct * T;
 
-        /* todo: optimizations, e.g. direct transfer of number field
-           elements where permissible */
-        ca_get_fexpr(expr, src, CA_FEXPR_SERIALIZATION, src_ctx);
+        /* Automatic sweeps are postponed while the translation table
+           is in use, since they could evict objects recorded in it. */
+        ca_ctx_lock(res_ctx);
+        res_ctx->cache_depth++;
 
-        if (!ca_set_fexpr(res, expr, res_ctx))
-        {
-            flint_printf("ca_transfer: failed to recreate from expression!\n");
-            flint_abort();
-        }
+        T = _ca_ctx_transfer_table(res_ctx, src_ctx);
+        _ca_transfer(res, res_ctx, src, src_ctx, T);
 
-        fexpr_clear(expr);
+        res_ctx->cache_depth--;
+        ca_ctx_unlock(res_ctx);
     }
 }
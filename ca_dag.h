@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CA_DAG_H
+#define CA_DAG_H
+
+#include "ca.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Expression DAG object */
+
+#define CA_DAG_LEAF (-1)
+
+typedef struct
+{
+    slong op;                 /* calcium_func_code, or CA_DAG_LEAF */
+    slong x;                  /* Argument nodes, or -1 */
+    slong y;
+    ulong hash;
+}
+ca_dag_node_struct;
+
+typedef struct
+{
+    ca_dag_node_struct * nodes;
+    ca_ptr values;            /* Values of leaves and of evaluated nodes */
+    int * evaluated;
+    slong length;
+    slong alloc;
+    slong * hash_table;       /* Node indices for common subexpressions */
+    slong hash_size;
+}
+ca_dag_struct;
+
+typedef ca_dag_struct ca_dag_t[1];
+
+#define ca_dag_length(dag) ((dag)->length)
+
+/* Memory management */
+
+void ca_dag_init(ca_dag_t dag, ca_ctx_t ctx);
+void ca_dag_clear(ca_dag_t dag, ca_ctx_t ctx);
+
+/* Construction */
+
+slong _ca_dag_node(ca_dag_t dag, slong op, slong x, slong y, ca_ctx_t ctx);
+
+slong ca_dag_set_ca(ca_dag_t dag, const ca_t x, ca_ctx_t ctx);
+slong ca_dag_set_si(ca_dag_t dag, slong x, ca_ctx_t ctx);
+
+slong ca_dag_add(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx);
+slong ca_dag_sub(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx);
+slong ca_dag_mul(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx);
+slong ca_dag_div(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx);
+slong ca_dag_neg(ca_dag_t dag, slong x, ca_ctx_t ctx);
+slong ca_dag_pow(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx);
+slong ca_dag_sqrt(ca_dag_t dag, slong x, ca_ctx_t ctx);
+slong ca_dag_exp(ca_dag_t dag, slong x, ca_ctx_t ctx);
+slong ca_dag_log(ca_dag_t dag, slong x, ca_ctx_t ctx);
+
+/* Evaluation */
+
+void ca_dag_get_ca(ca_t res, ca_dag_t dag, slong node, ca_ctx_t ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+void
+ca_dag_clear(ca_dag_t dag, ca_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < dag->length; i++)
+        ca_clear(dag->values + i, ctx);
+
+    flint_free(dag->nodes);
+    flint_free(dag->values);
+    flint_free(dag->evaluated);
+    flint_free(dag->hash_table);
+}
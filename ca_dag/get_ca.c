@@ -0,0 +1,353 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+#define IS_ARITH(op) ((op) == CA_Add || (op) == CA_Sub || (op) == CA_Mul || (op) == CA_Div || (op) == CA_Neg)
+
+static void
+_ca_dag_apply(ca_t res, slong op, const ca_t x, const ca_t y, ca_ctx_t ctx)
+{
+    switch (op)
+    {
+        case CA_Add: ca_add(res, x, y, ctx); break;
+        case CA_Sub: ca_sub(res, x, y, ctx); break;
+        case CA_Mul: ca_mul(res, x, y, ctx); break;
+        case CA_Div: ca_div(res, x, y, ctx); break;
+        case CA_Neg: ca_neg(res, x, ctx); break;
+        case CA_Pow: ca_pow(res, x, y, ctx); break;
+        case CA_Sqrt: ca_sqrt(res, x, ctx); break;
+        case CA_Exp: ca_exp(res, x, ctx); break;
+        case CA_Log: ca_log(res, x, ctx); break;
+        default:
+            flint_printf("ca_dag_get_ca: unsupported operation\n");
+            flint_abort();
+    }
+}
+
+static int
+_slong_cmp(const void * a, const void * b)
+{
+    slong x = *((const slong *) a);
+    slong y = *((const slong *) b);
+
+    return (x > y) - (x < y);
+}
+
+/* Evaluates a region of unreduced arithmetic in the field spanned by
+   its atoms. Returns 0 if the region contains a division whose
+   divisor cannot be proved nonzero. */
+static int
+_ca_dag_eval_region_lazy(ca_t res, ca_dag_t dag, const slong * region, slong rlen,
+    const slong * atoms, slong alen, slong * slot, ca_ctx_t ctx)
+{
+    ca_ptr conv;
+    ca_struct * avals;
+    ca_field_srcptr K;
+    fmpz_mpoly_ctx_struct * mctx;
+    fmpz_mpoly_q_struct * v;
+    fmpz_mpoly_q_struct * a;
+    fmpz_mpoly_q_struct * b;
+    ca_dag_node_struct * node;
+    ca_t t;
+    slong i, j;
+    int success;
+
+    for (i = 0; i < alen; i++)
+        if (CA_IS_SPECIAL(dag->values + atoms[i]))
+            return 0;
+
+    /* shallow copies, so that the atoms form a contiguous vector */
+    avals = flint_malloc(sizeof(ca_struct) * alen);
+    for (i = 0; i < alen; i++)
+        avals[i] = dag->values[atoms[i]];
+
+    conv = flint_malloc(sizeof(ca_struct) * alen);
+    for (i = 0; i < alen; i++)
+        ca_init(conv + i, ctx);
+
+    K = _ca_merge_fields_vec(conv, avals, alen, ctx);
+    flint_free(avals);
+
+    success = 0;
+
+    if (CA_FIELD_IS_GENERIC(K))
+    {
+        mctx = CA_FIELD_MCTX(K, ctx);
+
+        v = flint_malloc(sizeof(fmpz_mpoly_q_struct) * rlen);
+        for (j = 0; j < rlen; j++)
+            fmpz_mpoly_q_init(v + j, mctx);
+
+        ca_init(t, ctx);
+        success = 1;
+
+        for (j = 0; j < rlen && success; j++)
+        {
+            node = dag->nodes + region[j];
+
+            if (slot[node->x] < alen)
+                a = CA_MPOLY_Q(conv + slot[node->x]);
+            else
+                a = v + slot[node->x] - alen;
+
+            b = NULL;
+            if (node->y != -1)
+            {
+                if (slot[node->y] < alen)
+                    b = CA_MPOLY_Q(conv + slot[node->y]);
+                else
+                    b = v + slot[node->y] - alen;
+            }
+
+            switch (node->op)
+            {
+                case CA_Add: fmpz_mpoly_q_add(v + j, a, b, mctx); break;
+                case CA_Sub: fmpz_mpoly_q_sub(v + j, a, b, mctx); break;
+                case CA_Mul: fmpz_mpoly_q_mul(v + j, a, b, mctx); break;
+                case CA_Neg: fmpz_mpoly_q_neg(v + j, a, mctx); break;
+                default:
+                    /* the divisor is an unreduced representative; reduce
+                       it before deciding whether it is zero */
+                    _ca_make_field_element(t, K, ctx);
+                    fmpz_mpoly_q_set(CA_MPOLY_Q(t), b, mctx);
+                    _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(t), K, ctx);
+
+                    if (ca_check_is_zero(t, ctx) == T_FALSE)
+                        fmpz_mpoly_q_div(v + j, a, CA_MPOLY_Q(t), mctx);
+                    else
+                        success = 0;
+            }
+        }
+
+        if (success)
+        {
+            _ca_make_field_element(res, K, ctx);
+            fmpz_mpoly_q_swap(CA_MPOLY_Q(res), v + rlen - 1, mctx);
+            _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), K, ctx);
+            _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), K, ctx);
+            ca_condense_field(res, ctx);
+        }
+
+        ca_clear(t, ctx);
+
+        for (j = 0; j < rlen; j++)
+            fmpz_mpoly_q_clear(v + j, mctx);
+        flint_free(v);
+    }
+
+    for (i = 0; i < alen; i++)
+        ca_clear(conv + i, ctx);
+    flint_free(conv);
+
+    return success;
+}
+
+static void
+_ca_dag_eval_region_eager(ca_t res, ca_dag_t dag, const slong * region, slong rlen,
+    const slong * atoms, slong alen, slong * slot, ca_ctx_t ctx)
+{
+    ca_ptr v;
+    ca_srcptr a, b;
+    ca_dag_node_struct * node;
+    slong j;
+
+    v = flint_malloc(sizeof(ca_struct) * rlen);
+    for (j = 0; j < rlen; j++)
+        ca_init(v + j, ctx);
+
+    for (j = 0; j < rlen; j++)
+    {
+        node = dag->nodes + region[j];
+
+        if (slot[node->x] < alen)
+            a = dag->values + atoms[slot[node->x]];
+        else
+            a = v + slot[node->x] - alen;
+
+        b = NULL;
+        if (node->y != -1)
+        {
+            if (slot[node->y] < alen)
+                b = dag->values + atoms[slot[node->y]];
+            else
+                b = v + slot[node->y] - alen;
+        }
+
+        _ca_dag_apply(v + j, node->op, a, b, ctx);
+    }
+
+    ca_swap(res, v + rlen - 1, ctx);
+
+    for (j = 0; j < rlen; j++)
+        ca_clear(v + j, ctx);
+    flint_free(v);
+}
+
+/* Evaluates the arithmetic node r together with all unevaluated
+   arithmetic nodes that feed only into it. */
+static void
+_ca_dag_eval_region(ca_dag_t dag, slong r, slong * slot, ca_ctx_t ctx)
+{
+    slong * region;
+    slong * atoms;
+    slong * stack;
+    slong rlen, alen, depth, i, j, k, arg;
+    ca_dag_node_struct * node;
+
+    region = flint_malloc(sizeof(slong) * (r + 1));
+    atoms = flint_malloc(sizeof(slong) * 2 * (r + 1));
+    stack = flint_malloc(sizeof(slong) * (r + 1));
+
+    rlen = alen = 0;
+    depth = 0;
+    stack[depth++] = r;
+
+    while (depth > 0)
+    {
+        i = stack[--depth];
+        region[rlen++] = i;
+        node = dag->nodes + i;
+
+        for (k = 0; k < 2; k++)
+        {
+            arg = (k == 0) ? node->x : node->y;
+
+            if (arg == -1)
+                continue;
+
+            if (dag->evaluated[arg])
+            {
+                if (slot[arg] == -1)
+                {
+                    slot[arg] = alen;
+                    atoms[alen++] = arg;
+                }
+            }
+            else
+            {
+                stack[depth++] = arg;
+            }
+        }
+    }
+
+    /* evaluate in topological order; r comes last */
+    qsort(region, rlen, sizeof(slong), _slong_cmp);
+
+    for (j = 0; j < rlen; j++)
+        slot[region[j]] = alen + j;
+
+    if (rlen == 1 || !_ca_dag_eval_region_lazy(dag->values + r, dag, region, rlen, atoms, alen, slot, ctx))
+        _ca_dag_eval_region_eager(dag->values + r, dag, region, rlen, atoms, alen, slot, ctx);
+
+    for (j = 0; j < rlen; j++)
+        slot[region[j]] = -1;
+    for (j = 0; j < alen; j++)
+        slot[atoms[j]] = -1;
+
+    flint_free(region);
+    flint_free(atoms);
+    flint_free(stack);
+}
+
+void
+ca_dag_get_ca(ca_t res, ca_dag_t dag, slong node, ca_ctx_t ctx)
+{
+    slong i, n, x, y;
+    slong * uses;
+    slong * slot;
+    int * reached;
+    int * materialize;
+
+    if (node < 0 || node >= dag->length)
+    {
+        flint_printf("ca_dag_get_ca: invalid node\n");
+        flint_abort();
+    }
+
+    if (!dag->evaluated[node])
+    {
+        n = node + 1;
+
+        uses = flint_calloc(n, sizeof(slong));
+        reached = flint_calloc(n, sizeof(int));
+        materialize = flint_calloc(n, sizeof(int));
+        slot = flint_malloc(sizeof(slong) * n);
+
+        for (i = 0; i < n; i++)
+            slot[i] = -1;
+
+        /* Find the unevaluated nodes that the target depends on. An
+           arithmetic node is materialized as a ca_t only if it is shared
+           or used as the argument of a non-arithmetic operation;
+           all other arithmetic is folded into the region of its
+           consumer. */
+        reached[node] = 1;
+        materialize[node] = 1;
+
+        for (i = node; i >= 0; i--)
+        {
+            if (!reached[i] || dag->evaluated[i])
+                continue;
+
+            x = dag->nodes[i].x;
+            y = dag->nodes[i].y;
+
+            if (!IS_ARITH(dag->nodes[i].op))
+            {
+                materialize[i] = 1;
+                materialize[x] = 1;
+                if (y != -1)
+                    materialize[y] = 1;
+            }
+
+            reached[x] = 1;
+            uses[x]++;
+
+            /* x - x and x * x count as two uses */
+            if (y != -1)
+            {
+                reached[y] = 1;
+                uses[y]++;
+            }
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            if (!reached[i] || dag->evaluated[i])
+                continue;
+
+            if (!materialize[i] && uses[i] <= 1)
+                continue;
+
+            if (IS_ARITH(dag->nodes[i].op))
+            {
+                _ca_dag_eval_region(dag, i, slot, ctx);
+            }
+            else
+            {
+                x = dag->nodes[i].x;
+                y = dag->nodes[i].y;
+                _ca_dag_apply(dag->values + i, dag->nodes[i].op, dag->values + x,
+                    (y == -1) ? NULL : dag->values + y, ctx);
+            }
+
+            dag->evaluated[i] = 1;
+        }
+
+        flint_free(uses);
+        flint_free(reached);
+        flint_free(materialize);
+        flint_free(slot);
+    }
+
+    ca_set(res, dag->values + node, ctx);
+}
@@ -0,0 +1,24 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+void
+ca_dag_init(ca_dag_t dag, ca_ctx_t ctx)
+{
+    dag->nodes = NULL;
+    dag->values = NULL;
+    dag->evaluated = NULL;
+    dag->length = 0;
+    dag->alloc = 0;
+    dag->hash_table = NULL;
+    dag->hash_size = 0;
+}
@@ -0,0 +1,189 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+static ulong
+_ca_dag_op_hash(slong op, slong x, slong y)
+{
+    return ((ulong) op * 1000003 + (ulong) x) * 1000003 + (ulong) y;
+}
+
+static int
+_ca_dag_node_equal(const ca_dag_t dag, slong i, slong op, slong x, slong y, const ca_t v, ca_ctx_t ctx)
+{
+    const ca_dag_node_struct * node = dag->nodes + i;
+
+    if (node->op != op)
+        return 0;
+
+    if (op == CA_DAG_LEAF)
+        return ca_equal_repr(dag->values + i, v, ctx);
+
+    return node->x == x && node->y == y;
+}
+
+static void
+_ca_dag_hash_insert(ca_dag_t dag, slong i)
+{
+    slong j, mask;
+
+    mask = dag->hash_size - 1;
+    j = dag->nodes[i].hash & mask;
+
+    while (dag->hash_table[j] != -1)
+        j = (j + 1) & mask;
+
+    dag->hash_table[j] = i;
+}
+
+static void
+_ca_dag_fit_length(ca_dag_t dag, slong len, ca_ctx_t ctx)
+{
+    slong i, alloc;
+
+    if (len > dag->alloc)
+    {
+        alloc = FLINT_MAX(len, 2 * dag->alloc);
+        alloc = FLINT_MAX(alloc, 16);
+
+        dag->nodes = flint_realloc(dag->nodes, sizeof(ca_dag_node_struct) * alloc);
+        dag->values = flint_realloc(dag->values, sizeof(ca_struct) * alloc);
+        dag->evaluated = flint_realloc(dag->evaluated, sizeof(int) * alloc);
+        dag->alloc = alloc;
+    }
+
+    /* keep the load factor of the hash table below 1/2 */
+    if (2 * len > dag->hash_size)
+    {
+        dag->hash_size = FLINT_MAX(dag->hash_size, 32);
+        while (2 * len > dag->hash_size)
+            dag->hash_size *= 2;
+
+        flint_free(dag->hash_table);
+        dag->hash_table = flint_malloc(sizeof(slong) * dag->hash_size);
+
+        for (i = 0; i < dag->hash_size; i++)
+            dag->hash_table[i] = -1;
+
+        for (i = 0; i < dag->length; i++)
+            _ca_dag_hash_insert(dag, i);
+    }
+}
+
+/* Returns the node for (op, x, y), or for the leaf with value v,
+   creating it unless an identical node already exists. */
+static slong
+_ca_dag_find_or_insert(ca_dag_t dag, slong op, slong x, slong y, const ca_t v, ca_ctx_t ctx)
+{
+    ulong hash;
+    slong i, j, mask;
+
+    if (op == CA_DAG_LEAF)
+        hash = ca_hash_repr(v, ctx);
+    else
+        hash = _ca_dag_op_hash(op, x, y);
+
+    if (dag->hash_size != 0)
+    {
+        mask = dag->hash_size - 1;
+
+        for (j = hash & mask; (i = dag->hash_table[j]) != -1; j = (j + 1) & mask)
+        {
+            if (dag->nodes[i].hash == hash && _ca_dag_node_equal(dag, i, op, x, y, v, ctx))
+                return i;
+        }
+    }
+
+    _ca_dag_fit_length(dag, dag->length + 1, ctx);
+
+    i = dag->length;
+    dag->nodes[i].op = op;
+    dag->nodes[i].x = x;
+    dag->nodes[i].y = y;
+    dag->nodes[i].hash = hash;
+    ca_init(dag->values + i, ctx);
+
+    if (op == CA_DAG_LEAF)
+    {
+        ca_set(dag->values + i, v, ctx);
+        dag->evaluated[i] = 1;
+    }
+    else
+    {
+        dag->evaluated[i] = 0;
+    }
+
+    dag->length++;
+    _ca_dag_hash_insert(dag, i);
+
+    return i;
+}
+
+slong
+_ca_dag_node(ca_dag_t dag, slong op, slong x, slong y, ca_ctx_t ctx)
+{
+    int unary;
+
+    switch (op)
+    {
+        case CA_Neg:
+        case CA_Sqrt:
+        case CA_Exp:
+        case CA_Log:
+            unary = 1;
+            break;
+        case CA_Add:
+        case CA_Sub:
+        case CA_Mul:
+        case CA_Div:
+        case CA_Pow:
+            unary = 0;
+            break;
+        default:
+            flint_printf("_ca_dag_node: unsupported operation\n");
+            flint_abort();
+            return -1;
+    }
+
+    if (x < 0 || x >= dag->length ||
+        (unary ? (y != -1) : (y < 0 || y >= dag->length)))
+    {
+        flint_printf("_ca_dag_node: invalid argument node\n");
+        flint_abort();
+    }
+
+    /* normalize commutative operations */
+    if ((op == CA_Add || op == CA_Mul) && x > y)
+        return _ca_dag_find_or_insert(dag, op, y, x, NULL, ctx);
+
+    return _ca_dag_find_or_insert(dag, op, x, y, NULL, ctx);
+}
+
+slong
+ca_dag_set_ca(ca_dag_t dag, const ca_t x, ca_ctx_t ctx)
+{
+    return _ca_dag_find_or_insert(dag, CA_DAG_LEAF, -1, -1, x, ctx);
+}
+
+slong
+ca_dag_set_si(ca_dag_t dag, slong x, ca_ctx_t ctx)
+{
+    ca_t t;
+    slong i;
+
+    ca_init(t, ctx);
+    ca_set_si(t, x, ctx);
+    i = ca_dag_set_ca(dag, t, ctx);
+    ca_clear(t, ctx);
+
+    return i;
+}
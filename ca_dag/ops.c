@@ -0,0 +1,66 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+slong
+ca_dag_add(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Add, x, y, ctx);
+}
+
+slong
+ca_dag_sub(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Sub, x, y, ctx);
+}
+
+slong
+ca_dag_mul(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Mul, x, y, ctx);
+}
+
+slong
+ca_dag_div(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Div, x, y, ctx);
+}
+
+slong
+ca_dag_neg(ca_dag_t dag, slong x, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Neg, x, -1, ctx);
+}
+
+slong
+ca_dag_pow(ca_dag_t dag, slong x, slong y, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Pow, x, y, ctx);
+}
+
+slong
+ca_dag_sqrt(ca_dag_t dag, slong x, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Sqrt, x, -1, ctx);
+}
+
+slong
+ca_dag_exp(ca_dag_t dag, slong x, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Exp, x, -1, ctx);
+}
+
+slong
+ca_dag_log(ca_dag_t dag, slong x, ca_ctx_t ctx)
+{
+    return _ca_dag_node(dag, CA_Log, x, -1, ctx);
+}
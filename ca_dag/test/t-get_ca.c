@@ -0,0 +1,144 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_dag.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("get_ca....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_dag_t dag;
+        ca_ptr v;
+        ca_t t;
+        slong * node;
+        slong i, j, k, n, len;
+        int op;
+
+        ca_ctx_init(ctx);
+        ca_dag_init(dag, ctx);
+        ca_init(t, ctx);
+
+        n = 2 + n_randint(state, 20);
+
+        /* v[i] is the eagerly computed value of node[i] */
+        v = flint_malloc(sizeof(ca_struct) * n);
+        node = flint_malloc(sizeof(slong) * n);
+        for (i = 0; i < n; i++)
+            ca_init(v + i, ctx);
+
+        len = 1 + n_randint(state, 3);
+
+        for (i = 0; i < n; i++)
+        {
+            if (i < len)
+            {
+                if (n_randint(state, 2))
+                    ca_randtest_rational(v + i, state, 5, ctx);
+                else
+                    ca_randtest(v + i, state, 2, 5, ctx);
+
+                node[i] = ca_dag_set_ca(dag, v + i, ctx);
+                continue;
+            }
+
+            j = n_randint(state, i);
+            k = n_randint(state, i);
+            op = n_randint(state, 10);
+
+            switch (op)
+            {
+                case 0:
+                case 1:
+                    ca_add(v + i, v + j, v + k, ctx);
+                    node[i] = ca_dag_add(dag, node[j], node[k], ctx);
+                    break;
+                case 2:
+                    ca_sub(v + i, v + j, v + k, ctx);
+                    node[i] = ca_dag_sub(dag, node[j], node[k], ctx);
+                    break;
+                case 3:
+                case 4:
+                    ca_mul(v + i, v + j, v + k, ctx);
+                    node[i] = ca_dag_mul(dag, node[j], node[k], ctx);
+                    break;
+                case 5:
+                    ca_div(v + i, v + j, v + k, ctx);
+                    node[i] = ca_dag_div(dag, node[j], node[k], ctx);
+                    break;
+                case 6:
+                    ca_neg(v + i, v + j, ctx);
+                    node[i] = ca_dag_neg(dag, node[j], ctx);
+                    break;
+                case 7:
+                    ca_sqrt(v + i, v + j, ctx);
+                    node[i] = ca_dag_sqrt(dag, node[j], ctx);
+                    break;
+                default:
+                    /* repeat an earlier operation to exercise
+                       common subexpression elimination */
+                    ca_mul(v + i, v + k, v + j, ctx);
+                    node[i] = ca_dag_mul(dag, node[k], node[j], ctx);
+                    if (ca_dag_mul(dag, node[j], node[k], ctx) != node[i])
+                    {
+                        flint_printf("FAIL: common subexpression\n");
+                        flint_abort();
+                    }
+                    break;
+            }
+        }
+
+        /* evaluate a random node first, so that the final evaluation
+           also reuses materialized values */
+        i = n_randint(state, n);
+        ca_dag_get_ca(t, dag, node[i], ctx);
+
+        if (ca_check_equal(t, v + i, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL (node %wd)\n", i);
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_printf("v = "); ca_print(v + i, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        ca_dag_get_ca(t, dag, node[n - 1], ctx);
+
+        if (ca_check_equal(t, v + n - 1, ctx) == T_FALSE)
+        {
+            flint_printf("FAIL\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_printf("v = "); ca_print(v + n - 1, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < n; i++)
+            ca_clear(v + i, ctx);
+        flint_free(v);
+        flint_free(node);
+
+        ca_clear(t, ctx);
+        ca_dag_clear(dag, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
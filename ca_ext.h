@@ -52,6 +52,8 @@ ca_ext_init_set(ca_ext_t res, const ca_ext_t x, ca_ctx_t ctx)
 
 void ca_ext_clear(ca_ext_t res, ca_ctx_t ctx);
 
+slong ca_ext_allocated_bytes(const ca_ext_t x, ca_ctx_t ctx);
+
 CA_EXT_INLINE slong ca_ext_nargs(const ca_ext_t x, ca_ctx_t ctx)
 {
     if (CA_EXT_HEAD(x) == CA_QQBar)
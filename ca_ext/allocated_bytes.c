@@ -0,0 +1,43 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_ext.h"
+
+slong
+ca_ext_allocated_bytes(const ca_ext_t x, ca_ctx_t ctx)
+{
+    slong i, size;
+
+    size = sizeof(ca_ext_struct);
+
+    if (CA_EXT_IS_QQBAR(x))
+    {
+        const fmpz_poly_struct * poly = QQBAR_POLY(CA_EXT_QQBAR(x));
+
+        /* the number field stores a few polynomials of the same size */
+        size += 4 * poly->alloc * sizeof(fmpz);
+        size += acb_allocated_bytes(QQBAR_ENCLOSURE(CA_EXT_QQBAR(x)));
+        size += sizeof(nf_struct);
+    }
+    else
+    {
+        size += acb_allocated_bytes(CA_EXT_FUNC_ENCLOSURE(x));
+
+        for (i = 0; i < CA_EXT_FUNC_NARGS(x); i++)
+            size += sizeof(ca_struct) + ca_allocated_bytes(CA_EXT_FUNC_ARGS(x) + i, ctx);
+
+        if (x->data.func_data.qqbar != NULL)
+            size += sizeof(qqbar_struct) +
+                QQBAR_POLY(x->data.func_data.qqbar)->alloc * sizeof(fmpz);
+    }
+
+    return size;
+}
@@ -11,7 +11,31 @@
 
 #include "ca_ext.h"
 
-ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t ctx)
+static ca_ext_ptr
+_ca_ext_cache_lookup(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t ctx)
+{
+    slong i, loc;
+
+    loc = ca_ext_hash(x, ctx) % ((ulong) cache->hash_size);
+
+    for (i = 0; i < cache->hash_size; i++)
+    {
+        if (cache->hash_table[loc] == -1)
+            return NULL;
+
+        if (ca_ext_equal_repr(cache->items[cache->hash_table[loc]], x, ctx))
+            return cache->items[cache->hash_table[loc]];
+
+        loc++;
+        if (loc == cache->hash_size)
+            loc = 0;
+    }
+
+    return NULL;
+}
+
+static ca_ext_ptr
+_ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t ctx)
 {
     ulong xhash;
     slong i, loc;
@@ -76,6 +100,9 @@ ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t
         if (cache->hash_table[loc] == -1)
         {
             ca_ext_init_set(cache->items[cache->length], x, ctx);
+            cache->items[cache->length]->gen = ctx->cache_gen;
+            ctx->cache_bytes += ca_ext_allocated_bytes(cache->items[cache->length], ctx);
+            ctx->stats.ext_cache_misses++;
             cache->hash_table[loc] = cache->length;
             cache->length++;
             return cache->items[cache->length - 1];
@@ -83,7 +110,11 @@ ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t
 
         /* found */
         if (ca_ext_equal_repr(cache->items[cache->hash_table[loc]], x, ctx))
+        {
+            cache->items[cache->hash_table[loc]]->gen = ctx->cache_gen;
+            ctx->stats.ext_cache_hits++;
             return cache->items[cache->hash_table[loc]];
+        }
 
         loc++;
         if (loc == cache->hash_size)
@@ -94,3 +125,31 @@ ca_ext_ptr ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t
     flint_abort();
 }
 
+
+ca_ext_ptr
+ca_ext_cache_insert(ca_ext_cache_t cache, const ca_ext_t x, ca_ctx_t ctx)
+{
+    ca_ext_ptr res;
+    ca_ctx_struct * parent;
+    int locked;
+
+    /* ancestors may still grow, so they are read under their locks */
+    for (parent = ctx->parent; parent != NULL; parent = parent->parent)
+    {
+        locked = _ca_ctx_lock_shared(parent);
+        res = _ca_ext_cache_lookup(CA_CTX_EXT_CACHE(parent), x, parent);
+        _ca_ctx_unlock_shared(parent, locked);
+
+        if (res != NULL)
+        {
+            CA_CTX_STATS_ADD(ctx, ext_cache_hits, 1);
+            return res;
+        }
+    }
+
+    locked = _ca_ctx_lock_shared(ctx);
+    res = _ca_ext_cache_insert(cache, x, ctx);
+    _ca_ctx_unlock_shared(ctx, locked);
+
+    return res;
+}
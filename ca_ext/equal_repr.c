@@ -16,6 +16,10 @@ ca_ext_equal_repr(const ca_ext_t x, const ca_ext_t y, ca_ctx_t ctx)
 {
     slong i, nargs;
 
+    /* cached extension numbers are unique */
+    if (x == y)
+        return 1;
+
     if (CA_EXT_HASH(x) != CA_EXT_HASH(y))
         return 0;
 
@@ -59,18 +59,30 @@
 void
 ca_ext_get_acb_raw(acb_t res, ca_ext_t x, slong prec, ca_ctx_t ctx)
 {
+    int cached, locked;
+
+    /* Enclosures are refined in place under the lock of the context
+       owning x, which forks of that context also take. */
     if (CA_EXT_HEAD(x) == CA_QQBar)
     {
+        locked = _ca_ctx_lock_shared(x->owner);
         qqbar_cache_enclosure(CA_EXT_QQBAR(x), prec);
         qqbar_get_acb(res, CA_EXT_QQBAR(x), prec);
+        _ca_ctx_unlock_shared(x->owner, locked);
         return;
     }
 
-    if (prec <= CA_EXT_FUNC_PREC(x))
-    {
+    locked = _ca_ctx_lock_shared(x->owner);
+    cached = (prec <= CA_EXT_FUNC_PREC(x));
+    if (cached)
         acb_set(res, CA_EXT_FUNC_ENCLOSURE(x));
+    _ca_ctx_unlock_shared(x->owner, locked);
+
+    if (cached)
         return;
-    }
+
+    /* The evaluation is done without holding the lock; if several threads
+       refine the same enclosure, the most precise result wins. */
 
     switch (CA_EXT_HEAD(x))
     {
@@ -127,7 +139,12 @@ ca_ext_get_acb_raw(acb_t res, ca_ext_t x, slong prec, ca_ctx_t ctx)
             flint_abort();
     }
 
-    acb_set(CA_EXT_FUNC_ENCLOSURE(x), res);
-    CA_EXT_FUNC_PREC(x) = prec;
+    locked = _ca_ctx_lock_shared(x->owner);
+    if (prec > CA_EXT_FUNC_PREC(x))
+    {
+        acb_set(CA_EXT_FUNC_ENCLOSURE(x), res);
+        CA_EXT_FUNC_PREC(x) = prec;
+    }
+    _ca_ctx_unlock_shared(x->owner, locked);
 }
 
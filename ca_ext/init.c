@@ -46,8 +46,18 @@ ca_ext_init_qqbar(ca_ext_t res, const qqbar_t x, ca_ctx_t ctx)
     CA_EXT_QQBAR_NF(res) = flint_malloc(sizeof(nf_struct));
     nf_init(CA_EXT_QQBAR_NF(res), t);
 
+    /* cached for the cyclotomic fast paths */
+    if (!qqbar_is_root_of_unity(&CA_EXT_QQBAR_ROOT_P(res), &CA_EXT_QQBAR_ROOT_Q(res), x))
+    {
+        CA_EXT_QQBAR_ROOT_P(res) = 0;
+        CA_EXT_QQBAR_ROOT_Q(res) = 0;
+    }
+
     res->hash = qqbar_hash(CA_EXT_QQBAR(res));
     res->depth = 0;
+    res->refcount = 0;
+    res->owner = ctx;
+    res->gen = 0;
 }
 
 slong ca_depth(const ca_t x, ca_ctx_t ctx);
@@ -70,6 +80,9 @@ static void _ca_ext_init_func(ca_ext_t res, ca_ctx_t ctx)
     }
 
     res->data.func_data.qqbar = NULL;
+    res->refcount = 0;
+    res->owner = ctx;
+    res->gen = 0;
 }
 
 void
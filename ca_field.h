@@ -39,6 +39,8 @@ void ca_field_init_fxy(ca_field_t K, calcium_func_code func, const ca_t x, const
 void ca_field_init_multi(ca_field_t K, slong len, ca_ctx_t ctx);
 void ca_field_clear(ca_field_t K, ca_ctx_t ctx);
 
+slong ca_field_allocated_bytes(const ca_field_t K, ca_ctx_t ctx);
+
 void ca_field_set_ext(ca_field_t K, slong i, ca_ext_srcptr x, ca_ctx_t ctx);
 
 void ca_field_print(const ca_field_t K, ca_ctx_t ctx);
@@ -49,9 +51,15 @@ void ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx);
 void ca_field_build_ideal_erf(ca_field_t K, ca_ctx_t ctx);
 void ca_field_build_ideal_gamma(ca_field_t K, ca_ctx_t ctx);
 
+int ca_field_is_multiquadratic(const ca_field_t K, ca_ctx_t ctx);
+
+int ca_field_primitive_element(qqbar_t theta, fmpq_poly_struct * images,
+    const ca_field_t K, slong deg_limit, ca_ctx_t ctx);
+
 void ca_field_cache_init(ca_field_cache_t cache, ca_ctx_t ctx);
 void ca_field_cache_clear(ca_field_cache_t cache, ca_ctx_t ctx);
 ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, ca_ctx_t ctx);
+ca_field_ptr ca_field_cache_insert_ext_ideal(ca_field_cache_t cache, ca_ext_struct ** x, slong length, const fmpz_mpoly_vec_t ideal, int ideal_flags, ca_ctx_t ctx);
 
 #ifdef __cplusplus
 }
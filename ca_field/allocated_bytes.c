@@ -0,0 +1,25 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_field.h"
+
+slong
+ca_field_allocated_bytes(const ca_field_t K, ca_ctx_t ctx)
+{
+    slong size;
+
+    size = sizeof(ca_field_struct) + CA_FIELD_LENGTH(K) * sizeof(ca_ext_ptr);
+
+    if (CA_FIELD_IS_GENERIC(K))
+        size += fmpz_mpoly_vec_allocated_bytes(CA_FIELD_IDEAL(K), CA_FIELD_MCTX(K, ctx));
+
+    return size;
+}
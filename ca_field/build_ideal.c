@@ -387,7 +387,7 @@ ca_field_build_ideal_logs(ca_field_t K, ca_ctx_t ctx)
 
     len = CA_FIELD_LENGTH(K);
 
-    if (len < 2)
+    if (len < 2 || ca_ctx_budget_exceeded(ctx))
         return;
 
     num_logs = 0;
@@ -461,6 +461,7 @@ ca_field_build_ideal_logs(ca_field_t K, ca_ctx_t ctx)
         {
             fmpz_mat_init(A, 0, 0);
             acb_multi_lindep(A, z, num_logs_with_pi_i, 1, prec);
+            CA_CTX_STATS_ADD(ctx, lll_calls, 1);
 
             for (row = 0; row < fmpz_mat_nrows(A); row++)
             {
@@ -739,7 +740,7 @@ ca_field_build_ideal_multiplicative(ca_field_t K, ca_ctx_t ctx)
 
     len = CA_FIELD_LENGTH(K);
 
-    if (len == 0)
+    if (len == 0 || ca_ctx_budget_exceeded(ctx))
         return;
 
     num_powers = 0;
@@ -829,6 +830,7 @@ ca_field_build_ideal_multiplicative(ca_field_t K, ca_ctx_t ctx)
         {
             fmpz_mat_init(A, 0, 0);
             acb_multi_lindep(A, z, num_powers + 1, 1, prec);
+            CA_CTX_STATS_ADD(ctx, lll_calls, 1);
 
             for (row = 0; row < fmpz_mat_nrows(A); row++)
             {
@@ -892,10 +894,265 @@ fmpz_mpoly_set_coeff_si_x(fmpz_mpoly_t poly,
         slong x_var, slong x_exp,
         const fmpz_mpoly_ctx_t ctx);
 
+/* Called after each S-polynomial reduction; aborts the
+   Groebner basis computation when the work budget runs out. */
+static int
+_ca_field_groebner_callback(void * data)
+{
+    ca_ctx_struct * ctx = data;
+
+    CA_CTX_STATS_ADD(ctx, groebner_reductions, 1);
+    _ca_ctx_budget_charge(ctx, 1);
+    return ca_ctx_budget_exceeded(ctx);
+}
+
+/* Sets gen_map to the indices in K of the generators of L; returns 0 if
+   some generator of L is not a generator of K. */
+static int
+_ca_field_subfield_gen_map(slong * gen_map, const ca_field_t L, const ca_field_t K)
+{
+    slong i, j;
+
+    for (i = 0; i < CA_FIELD_LENGTH(L); i++)
+    {
+        for (j = 0; j < CA_FIELD_LENGTH(K); j++)
+            if (CA_FIELD_EXT_ELEM(L, i) == CA_FIELD_EXT_ELEM(K, j))
+                break;
+
+        if (j == CA_FIELD_LENGTH(K))
+            return 0;
+
+        gen_map[i] = j;
+    }
+
+    return 1;
+}
+
+/* Finds cached proper subfields of K whose ideals were built with complete
+   relation searches, greedily choosing the largest ones until no further
+   generators of K are covered. Writes at most len(K) subfields to sub and
+   returns the number of subfields found. */
+static slong
+_ca_field_find_subfields(ca_field_ptr * sub, const ca_field_t K, ca_ctx_t ctx)
+{
+    ca_field_cache_struct * cache = CA_CTX_FIELD_CACHE(ctx);
+    ca_field_ptr * cand;
+    ca_field_ptr L;
+    slong * gen_map;
+    int * covered;
+    slong i, j, len, num_cand, num_sub, best, best_new, num_new;
+
+    len = CA_FIELD_LENGTH(K);
+
+    cand = flint_malloc(sizeof(ca_field_ptr) * cache->length);
+    gen_map = flint_malloc(sizeof(slong) * len);
+    covered = flint_calloc(len, sizeof(int));
+
+    num_cand = 0;
+    for (i = 0; i < cache->length; i++)
+    {
+        L = cache->items[i];
+
+        if (L != K && CA_FIELD_IS_GENERIC(L) && CA_FIELD_LENGTH(L) < len &&
+            (L->ideal_flags & CA_FIELD_IDEAL_SEARCHED) &&
+            _ca_field_subfield_gen_map(gen_map, L, K))
+        {
+            cand[num_cand] = L;
+            num_cand++;
+        }
+    }
+
+    num_sub = 0;
+    while (num_sub < len)
+    {
+        best = -1;
+        best_new = 0;
+
+        for (i = 0; i < num_cand; i++)
+        {
+            _ca_field_subfield_gen_map(gen_map, cand[i], K);
+
+            num_new = 0;
+            for (j = 0; j < CA_FIELD_LENGTH(cand[i]); j++)
+                num_new += !covered[gen_map[j]];
+
+            if (num_new > best_new)
+            {
+                best = i;
+                best_new = num_new;
+            }
+        }
+
+        if (best == -1)
+            break;
+
+        _ca_field_subfield_gen_map(gen_map, cand[best], K);
+        for (j = 0; j < CA_FIELD_LENGTH(cand[best]); j++)
+            covered[gen_map[j]] = 1;
+
+        sub[num_sub] = cand[best];
+        num_sub++;
+    }
+
+    flint_free(cand);
+    flint_free(gen_map);
+    flint_free(covered);
+
+    return num_sub;
+}
+
+/* Inserts the ideals of the subfields into the (empty) ideal of K.
+   Returns the number of leading entries of the ideal of K that are known
+   to form a Groebner basis: this is the case for the first subfield if
+   its ideal is a Groebner basis and its generators appear in the same
+   order in K, so that the monomial orders agree. */
+static slong
+_ca_field_seed_ideal(ca_field_t K, ca_field_ptr * sub, slong num_sub, ca_ctx_t ctx)
+{
+    ca_field_ptr L;
+    slong * gen_map;
+    fmpz_mpoly_t poly;
+    slong i, j, known_len;
+    int increasing;
+
+    gen_map = flint_malloc(sizeof(slong) * CA_FIELD_LENGTH(K));
+    known_len = 0;
+
+    for (i = 0; i < num_sub; i++)
+    {
+        L = sub[i];
+
+        _ca_field_subfield_gen_map(gen_map, L, K);
+
+        for (j = 0; j < CA_FIELD_IDEAL_LENGTH(L); j++)
+        {
+            fmpz_mpoly_init(poly, CA_FIELD_MCTX(K, ctx));
+            fmpz_mpoly_compose_fmpz_mpoly_gen(poly, CA_FIELD_IDEAL_ELEM(L, j),
+                gen_map, CA_FIELD_MCTX(L, ctx), CA_FIELD_MCTX(K, ctx));
+            _ca_field_ideal_insert_clear_mpoly(K, poly, CA_FIELD_MCTX(K, ctx), ctx);
+        }
+
+        if (i == 0 && (L->ideal_flags & CA_FIELD_IDEAL_GROEBNER))
+        {
+            increasing = 1;
+            for (j = 1; j < CA_FIELD_LENGTH(L); j++)
+                increasing = increasing && (gen_map[j - 1] < gen_map[j]);
+
+            if (increasing)
+                known_len = CA_FIELD_IDEAL_LENGTH(K);
+        }
+    }
+
+    flint_free(gen_map);
+
+    return known_len;
+}
+
+static int
+_ca_ext_in_log_search(ca_ext_srcptr x, ca_ctx_t ctx)
+{
+    return CA_EXT_HEAD(x) == CA_Log || CA_EXT_HEAD(x) == CA_Pi ||
+        x == CA_FIELD_EXT_ELEM(ctx->field_qq_i, 0);
+}
+
+static int
+_ca_ext_in_multiplicative_search(ca_ext_srcptr x, ca_ctx_t ctx)
+{
+    return CA_EXT_HEAD(x) == CA_Sqrt || CA_EXT_HEAD(x) == CA_Pow ||
+        CA_EXT_HEAD(x) == CA_Exp || CA_EXT_IS_QQBAR(x);
+}
+
+/* Whether all generators of K taking part in a relation search (as
+   selected by in_search) are generators of one of the subfields, in which
+   case the search would only rediscover the relations in that subfield. */
+static int
+_ca_field_search_done_in_subfield(const ca_field_t K, ca_field_ptr * sub, slong num_sub,
+    int (*in_search)(ca_ext_srcptr, ca_ctx_t), ca_ctx_t ctx)
+{
+    slong i, j, k, num;
+
+    for (i = 0; i < num_sub; i++)
+    {
+        num = 0;
+
+        for (j = 0; j < CA_FIELD_LENGTH(K); j++)
+        {
+            if (in_search(CA_FIELD_EXT_ELEM(K, j), ctx))
+            {
+                for (k = 0; k < CA_FIELD_LENGTH(sub[i]); k++)
+                    if (CA_FIELD_EXT_ELEM(sub[i], k) == CA_FIELD_EXT_ELEM(K, j))
+                        break;
+
+                if (k == CA_FIELD_LENGTH(sub[i]))
+                    break;
+
+                num++;
+            }
+        }
+
+        if (j == CA_FIELD_LENGTH(K))
+            return num != 0;
+    }
+
+    return 0;
+}
+
+/* If all generators are algebraic, the ideal is zero-dimensional and it is
+   usually much cheaper to compute a Groebner basis in degrevlex order and
+   convert it to lex order by linear algebra (FGLM) than to run Buchberger's
+   algorithm directly in lex order. Returns 0 (leaving the ideal unchanged)
+   if the computation fails within the limits. */
+static int
+_ca_field_groebner_fglm(ca_field_t K, ca_ctx_t ctx)
+{
+    fmpz_mpoly_ctx_t drl;
+    fmpz_mpoly_vec_t G;
+    slong * gen_map;
+    slong i, len;
+    int success;
+
+    len = CA_FIELD_LENGTH(K);
+
+    fmpz_mpoly_ctx_init(drl, len, ORD_DEGREVLEX);
+    fmpz_mpoly_vec_init(G, CA_FIELD_IDEAL_LENGTH(K), drl);
+    gen_map = flint_malloc(sizeof(slong) * len);
+
+    for (i = 0; i < len; i++)
+        gen_map[i] = i;
+
+    for (i = 0; i < CA_FIELD_IDEAL_LENGTH(K); i++)
+        fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_vec_entry(G, i),
+            CA_FIELD_IDEAL_ELEM(K, i), gen_map, CA_FIELD_MCTX(K, ctx), drl);
+
+    success = _fmpz_mpoly_buchberger_with_limits(G, G,
+        ctx->options[CA_OPT_GROEBNER_LENGTH_LIMIT],
+        ctx->options[CA_OPT_GROEBNER_POLY_LENGTH_LIMIT],
+        ctx->options[CA_OPT_GROEBNER_POLY_BITS_LIMIT],
+        _ca_field_groebner_callback, ctx, drl);
+
+    if (success)
+    {
+        fmpz_mpoly_vec_autoreduction_groebner(G, G, drl);
+
+        /* The lex basis has a polynomial with one term per standard
+           monomial, so the dimension is bounded by the length limit. */
+        success = fmpz_mpoly_vec_fglm(CA_FIELD_IDEAL(K), CA_FIELD_MCTX(K, ctx), G, drl,
+            ctx->options[CA_OPT_GROEBNER_POLY_LENGTH_LIMIT]);
+    }
+
+    fmpz_mpoly_vec_clear(G, drl);
+    fmpz_mpoly_ctx_clear(drl);
+    flint_free(gen_map);
+
+    return success;
+}
+
 void
 ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
 {
-    slong i, len;
+    slong i, len, num_sub, known_len;
+    ca_field_ptr * sub;
+    int skip_logs, skip_multiplicative;
 
     len = CA_FIELD_LENGTH(K);
 
@@ -905,6 +1162,36 @@ ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
     if (len == 1 && CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, 0)))
         return;
 
+    /* In Q(sqrt(p_1), ..., sqrt(p_n)) with independent radicands, the
+       relations x_i^2 - p_i already form a reduced Groebner basis. */
+    if (ca_field_is_multiquadratic(K, ctx))
+    {
+        for (i = 0; i < len; i++)
+        {
+            fmpz_mpoly_t poly;
+            fmpz_mpoly_init(poly, CA_FIELD_MCTX(K, ctx));
+            fmpz_mpoly_set_gen_fmpz_poly(poly, i, QQBAR_POLY(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))), CA_FIELD_MCTX(K, ctx));
+            _ca_field_ideal_insert_clear_mpoly(K, poly, CA_FIELD_MCTX(K, ctx), ctx);
+        }
+
+        K->ideal_flags = CA_FIELD_IDEAL_GROEBNER | CA_FIELD_IDEAL_SEARCHED | CA_FIELD_IDEAL_MULTIQUADRATIC;
+        return;
+    }
+
+    /* Start from the relations already found in cached subfields
+       (typically the fields merged to create K). The subfields are not
+       accessed after the relation searches start, since these
+       can trigger a cache sweep. */
+    sub = flint_malloc(sizeof(ca_field_ptr) * len);
+    num_sub = _ca_field_find_subfields(sub, K, ctx);
+    known_len = _ca_field_seed_ideal(K, sub, num_sub, ctx);
+    skip_logs = _ca_field_search_done_in_subfield(K, sub, num_sub, _ca_ext_in_log_search, ctx);
+    skip_multiplicative = _ca_field_search_done_in_subfield(K, sub, num_sub, _ca_ext_in_multiplicative_search, ctx);
+    flint_free(sub);
+
+    if (num_sub != 0)
+        CA_CTX_STATS_ADD(ctx, ideal_seeded, 1);
+
     /* Find direct algebraic relations. */
     if (len >= 2)
     {
@@ -1100,16 +1387,26 @@ ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
         }
     }
 
-    ca_field_build_ideal_logs(K, ctx);
-    ca_field_build_ideal_multiplicative(K, ctx);
+    if (skip_logs)
+        CA_CTX_STATS_ADD(ctx, lll_skipped, 1);
+    else
+        ca_field_build_ideal_logs(K, ctx);
+
+    if (skip_multiplicative)
+        CA_CTX_STATS_ADD(ctx, lll_skipped, 1);
+    else
+        ca_field_build_ideal_multiplicative(K, ctx);
+
     /* ca_field_build_ideal_sin_cos(K, ctx); */
     ca_field_build_ideal_erf(K, ctx);
     ca_field_build_ideal_gamma(K, ctx);
 
+    if (!ca_ctx_budget_exceeded(ctx))
+        K->ideal_flags |= CA_FIELD_IDEAL_SEARCHED;
+
     if (ctx->options[CA_OPT_USE_GROEBNER])
     {
-        slong i;
-        int want_groebner;
+        int want_groebner, success;
 
         want_groebner = 1;
         for (i = 0; i < CA_FIELD_IDEAL_LENGTH(K); i++)
@@ -1121,7 +1418,7 @@ ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
             }
         }
 
-        if (want_groebner && CA_FIELD_IDEAL(K)->length > 0)
+        if (want_groebner && CA_FIELD_IDEAL(K)->length > 0 && !ca_ctx_budget_exceeded(ctx))
         {
             if (ctx->options[CA_OPT_VERBOSE])
             {
@@ -1141,13 +1438,33 @@ ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
                     flint_printf("before, after: %wd %wd\n", before, after);
             }
 
-            if (fmpz_mpoly_buchberger_naive_with_limits(CA_FIELD_IDEAL(K), CA_FIELD_IDEAL(K),
-                ctx->options[CA_OPT_GROEBNER_LENGTH_LIMIT],
-                ctx->options[CA_OPT_GROEBNER_POLY_LENGTH_LIMIT],
-                ctx->options[CA_OPT_GROEBNER_POLY_BITS_LIMIT],
-                CA_FIELD_MCTX(K, ctx)))
+            CA_CTX_STATS_ADD(ctx, groebner_runs, 1);
+
+            success = 0;
+
+            if (ctx->options[CA_OPT_MPOLY_ORD] == ORD_LEX && len >= 2)
+            {
+                for (i = 0; i < len; i++)
+                    if (!CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, i)))
+                        break;
+
+                if (i == len)
+                    success = _ca_field_groebner_fglm(K, ctx);
+            }
+
+            if (!success)
+                success = _fmpz_mpoly_buchberger_extend_with_limits(CA_FIELD_IDEAL(K), CA_FIELD_IDEAL(K),
+                    known_len,
+                    ctx->options[CA_OPT_GROEBNER_LENGTH_LIMIT],
+                    ctx->options[CA_OPT_GROEBNER_POLY_LENGTH_LIMIT],
+                    ctx->options[CA_OPT_GROEBNER_POLY_BITS_LIMIT],
+                    _ca_field_groebner_callback, ctx,
+                    CA_FIELD_MCTX(K, ctx));
+
+            if (success)
             {
                 fmpz_mpoly_vec_autoreduction_groebner(CA_FIELD_IDEAL(K), CA_FIELD_IDEAL(K), CA_FIELD_MCTX(K, ctx));
+                K->ideal_flags |= CA_FIELD_IDEAL_GROEBNER;
 
                 if (ctx->options[CA_OPT_VERBOSE])
                 {
@@ -1165,4 +1482,7 @@ ca_field_build_ideal(ca_field_t K, ca_ctx_t ctx)
 
         }
     }
+
+    if (ca_ctx_budget_exceeded(ctx))
+        K->ideal_flags |= CA_FIELD_IDEAL_INCOMPLETE;
 }
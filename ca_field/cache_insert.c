@@ -12,7 +12,8 @@
 #include "ca_ext.h"
 #include "ca_field.h"
 
-ca_field_ptr ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x, ca_ctx_t ctx)
+static ca_field_ptr
+_ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x, ca_ctx_t ctx)
 {
     ulong xhash;
     ca_field_ptr K;
@@ -42,6 +43,32 @@ ca_field_ptr ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x
     flint_abort();
 }
 
+ca_field_ptr
+ca_field_cache_lookup_qqbar(ca_field_cache_t cache, const qqbar_t x, ca_ctx_t ctx)
+{
+    ca_field_ptr res;
+    ca_ctx_struct * parent;
+    int locked;
+
+    for (parent = ctx->parent; parent != NULL; parent = parent->parent)
+    {
+        locked = _ca_ctx_lock_shared(parent);
+        res = _ca_field_cache_lookup_qqbar(CA_CTX_FIELD_CACHE(parent), x, parent);
+        _ca_ctx_unlock_shared(parent, locked);
+
+        if (res != NULL)
+            return res;
+    }
+
+    locked = _ca_ctx_lock_shared(ctx);
+    res = _ca_field_cache_lookup_qqbar(cache, x, ctx);
+    if (res != NULL)
+        res->gen = ctx->cache_gen;
+    _ca_ctx_unlock_shared(ctx, locked);
+
+    return res;
+}
+
 ulong
 _ca_field_hash(ca_ext_struct ** ext, slong len, ca_ctx_t ctx)
 {
@@ -91,6 +118,11 @@ ca_field_init_set_ext(ca_field_t K, ca_ext_struct ** ext, slong len, ca_ctx_t ct
         CA_FIELD_IDEAL_LENGTH(K) = -1;
         CA_FIELD_IDEAL_ALLOC(K) = 0;
         CA_FIELD_HASH(K) = CA_EXT_HASH(ext[0]);
+        K->refcount = 0;
+        K->owner = ctx;
+        K->gen = 0;
+        K->prec_hint = 0;
+        K->ideal_flags = 0;
     }
     else
     {
@@ -103,8 +135,48 @@ ca_field_init_set_ext(ca_field_t K, ca_ext_struct ** ext, slong len, ca_ctx_t ct
     }
 }
 
+static ca_field_ptr
+_ca_field_cache_lookup_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, ca_ctx_t ctx)
+{
+    slong i, loc;
+
+    loc = _ca_field_hash(x, length, ctx) % ((ulong) cache->hash_size);
+
+    for (i = 0; i < cache->hash_size; i++)
+    {
+        if (cache->hash_table[loc] == -1)
+            return NULL;
 
-ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, ca_ctx_t ctx)
+        if (_ca_field_equal_ext(cache->items[cache->hash_table[loc]], x, length, ctx))
+            return cache->items[cache->hash_table[loc]];
+
+        loc++;
+        if (loc == cache->hash_size)
+            loc = 0;
+    }
+
+    return NULL;
+}
+
+/* Builds the ideal of K again, now that the budget allows the relation
+   searches that were skipped. Existing elements of K keep their values.
+   Translation tables into this context may record the old ideal,
+   so they are dropped. */
+static void
+_ca_field_rebuild_ideal(ca_field_t K, ca_ctx_t ctx)
+{
+    ctx->cache_bytes -= ca_field_allocated_bytes(K, ctx);
+
+    fmpz_mpoly_vec_set_length(CA_FIELD_IDEAL(K), 0, CA_FIELD_MCTX(K, ctx));
+    K->ideal_flags = 0;
+    ca_field_build_ideal(K, ctx);
+
+    ctx->cache_bytes += ca_field_allocated_bytes(K, ctx);
+    _ca_ctx_invalidate_transfer_tables(ctx);
+}
+
+static ca_field_ptr
+_ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, const fmpz_mpoly_vec_struct * ideal, int ideal_flags, ca_ctx_t ctx)
 {
     ulong xhash;
     slong i, loc;
@@ -169,6 +241,7 @@ ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct **
         if (cache->hash_table[loc] == -1)
         {
             ca_field_ptr res;
+            slong j;
 
             ca_field_init_set_ext(cache->items[cache->length], x, length, ctx);
             cache->hash_table[loc] = cache->length;
@@ -176,15 +249,55 @@ ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct **
 
             /* save pointer; build_ideal can resize the cache */
             res = cache->items[cache->length - 1];
+            res->gen = ctx->cache_gen;
 
-            ca_field_build_ideal(res, ctx);
+            for (j = 0; j < length; j++)
+                if (CA_CTX_OWNS(x[j], ctx))
+                    x[j]->refcount++;
+
+            if (ideal != NULL && CA_FIELD_IS_GENERIC(res))
+            {
+                fmpz_mpoly_vec_set(CA_FIELD_IDEAL(res), ideal, CA_FIELD_MCTX(res, ctx));
+                res->ideal_flags = ideal_flags;
+            }
+            else
+                ca_field_build_ideal(res, ctx);
+
+            ctx->cache_bytes += ca_field_allocated_bytes(res, ctx);
+            ctx->stats.field_cache_misses++;
+
+            if (CA_FIELD_IDEAL_LENGTH(res) > 0)
+            {
+                ctx->stats.ideal_length += CA_FIELD_IDEAL_LENGTH(res);
+                ctx->stats.ideal_max_length = FLINT_MAX(ctx->stats.ideal_max_length, CA_FIELD_IDEAL_LENGTH(res));
+            }
+            ctx->cache_sweep_countdown--;
 
             return res;
         }
 
         /* found */
         if (_ca_field_equal_ext(cache->items[cache->hash_table[loc]], x, length, ctx))
-            return cache->items[cache->hash_table[loc]];
+        {
+            ca_field_ptr res;
+
+            res = cache->items[cache->hash_table[loc]];
+            res->gen = ctx->cache_gen;
+            ctx->stats.field_cache_hits++;
+
+            /* Other threads and forks may be reducing by the ideal
+               without holding the lock, so it is only replaced when
+               nothing else can see it. A caller supplying an ideal
+               is in the middle of a transfer. */
+            if ((res->ideal_flags & CA_FIELD_IDEAL_INCOMPLETE) && ideal == NULL &&
+                !ctx->options[CA_OPT_THREAD_SAFE] && ctx->fork_count == 0 &&
+                !ca_ctx_budget_exceeded(ctx))
+            {
+                _ca_field_rebuild_ideal(res, ctx);
+            }
+
+            return res;
+        }
 
         loc++;
         if (loc == cache->hash_size)
@@ -194,3 +307,79 @@ ca_field_ptr ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct **
     /* cannot happen */
     flint_abort();
 }
+
+void _ca_ctx_init_mctx(ca_ctx_t ctx, slong len);
+
+/* Ancestors may still grow, so they are read under their locks. A field
+   created in an ancestor after ctx was forked may have more generators
+   than the multivariate contexts of ctx cover. */
+static ca_field_ptr
+_ca_field_cache_lookup_ext_ancestors(ca_ext_struct ** x, slong length, ca_ctx_t ctx)
+{
+    ca_field_ptr res;
+    ca_ctx_struct * parent;
+    int locked;
+
+    for (parent = ctx->parent; parent != NULL; parent = parent->parent)
+    {
+        locked = _ca_ctx_lock_shared(parent);
+        res = _ca_field_cache_lookup_ext(CA_CTX_FIELD_CACHE(parent), x, length, parent);
+        _ca_ctx_unlock_shared(parent, locked);
+
+        if (res != NULL)
+        {
+            if (length > ctx->mctx_len)
+                _ca_ctx_init_mctx(ctx, length);
+
+            return res;
+        }
+    }
+
+    return NULL;
+}
+
+/* The lock is held while the ideal is built so that other threads and
+   forks never see a field with an incomplete ideal. */
+ca_field_ptr
+ca_field_cache_insert_ext_ideal(ca_field_cache_t cache, ca_ext_struct ** x, slong length, const fmpz_mpoly_vec_t ideal, int ideal_flags, ca_ctx_t ctx)
+{
+    ca_field_ptr res;
+    int locked;
+
+    res = _ca_field_cache_lookup_ext_ancestors(x, length, ctx);
+
+    if (res != NULL)
+    {
+        CA_CTX_STATS_ADD(ctx, field_cache_hits, 1);
+        return res;
+    }
+
+    locked = _ca_ctx_lock_shared(ctx);
+
+    ctx->cache_depth++;
+    res = _ca_field_cache_insert_ext(cache, x, length, ideal, ideal_flags, ctx);
+    ctx->cache_depth--;
+
+    /* Only sweep from the outermost call: fields whose ideals are
+       still being built are not yet referenced by anything. In
+       thread-safe mode, other threads may hold raw pointers to fields
+       and extension numbers between a cache lookup and taking a
+       reference, so sweeps are left to the user. */
+    if (ctx->cache_depth == 0 && !ctx->options[CA_OPT_THREAD_SAFE] &&
+        ctx->options[CA_OPT_CACHE_MEM_LIMIT] > 0 &&
+        ctx->cache_bytes > ctx->options[CA_OPT_CACHE_MEM_LIMIT] &&
+        ctx->cache_sweep_countdown <= 0)
+    {
+        _ca_ctx_cache_sweep(ctx, 0);
+    }
+
+    _ca_ctx_unlock_shared(ctx, locked);
+
+    return res;
+}
+
+ca_field_ptr
+ca_field_cache_insert_ext(ca_field_cache_t cache, ca_ext_struct ** x, slong length, ca_ctx_t ctx)
+{
+    return ca_field_cache_insert_ext_ideal(cache, x, length, NULL, 0, ctx);
+}
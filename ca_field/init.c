@@ -16,19 +16,46 @@
 void
 _ca_ctx_init_mctx(ca_ctx_t ctx, slong len)
 {
+    ca_ctx_lock(ctx);
+
     while (ctx->mctx_len < len)
     {
         slong i, alloc;
+        fmpz_mpoly_ctx_struct ** mctx;
+
         alloc = FLINT_MAX(1, 2 * ctx->mctx_len);
-        ctx->mctx = flint_realloc(ctx->mctx, alloc * sizeof(fmpz_mpoly_ctx_struct *));
+
+        /* Other threads may be reading the old array without holding
+           the lock, so we keep it alive until the context is cleared
+           instead of reallocating in place. */
+        mctx = flint_malloc(alloc * sizeof(fmpz_mpoly_ctx_struct *));
+
+        for (i = 0; i < ctx->mctx_len; i++)
+            mctx[i] = ctx->mctx[i];
 
         for (i = ctx->mctx_len; i < alloc; i++)
         {
-            ctx->mctx[i] = flint_malloc(sizeof(fmpz_mpoly_ctx_struct));
-            fmpz_mpoly_ctx_init(ctx->mctx[i], i + 1, ctx->options[CA_OPT_MPOLY_ORD]);
+            mctx[i] = flint_malloc(sizeof(fmpz_mpoly_ctx_struct));
+            fmpz_mpoly_ctx_init(mctx[i], i + 1, ctx->options[CA_OPT_MPOLY_ORD]);
         }
+
+        if (ctx->mctx != NULL)
+        {
+            ctx->mctx_retired = flint_realloc(ctx->mctx_retired,
+                (ctx->mctx_retired_len + 1) * sizeof(fmpz_mpoly_ctx_struct **));
+            ctx->mctx_retired[ctx->mctx_retired_len] = ctx->mctx;
+            ctx->mctx_retired_len++;
+        }
+
+#if defined(__GNUC__)
+        /* publish the new array only once it has been filled */
+        __sync_synchronize();
+#endif
+        ctx->mctx = mctx;
         ctx->mctx_len = alloc;
     }
+
+    ca_ctx_unlock(ctx);
 }
 
 
@@ -41,6 +68,11 @@ ca_field_init_qq(ca_field_t K, ca_ctx_t ctx)
     CA_FIELD_IDEAL_LENGTH(K) = 0;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = 0;
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 }
 
 void
@@ -61,6 +93,11 @@ ca_field_init_nf(ca_field_t K, const qqbar_t x, ca_ctx_t ctx)
     CA_FIELD_IDEAL_LENGTH(K) = -1;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = CA_EXT_HASH(ext);
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 }
 
 void
@@ -81,6 +118,11 @@ ca_field_init_const(ca_field_t K, calcium_func_code func, ca_ctx_t ctx)
     CA_FIELD_IDEAL_LENGTH(K) = 0;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = CA_EXT_HASH(ext);
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 
     _ca_ctx_init_mctx(ctx, 1);
 }
@@ -102,6 +144,11 @@ void ca_field_init_fx(ca_field_t K, calcium_func_code func, const ca_t x, ca_ctx
     CA_FIELD_IDEAL_LENGTH(K) = 0;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = CA_EXT_HASH(ext);
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 
     _ca_ctx_init_mctx(ctx, 1);
 }
@@ -123,6 +170,11 @@ void ca_field_init_fxy(ca_field_t K, calcium_func_code func, const ca_t x, const
     CA_FIELD_IDEAL_LENGTH(K) = 0;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = CA_EXT_HASH(ext);
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 
     _ca_ctx_init_mctx(ctx, 2);
 }
@@ -136,6 +188,11 @@ ca_field_init_multi(ca_field_t K, slong len, ca_ctx_t ctx)
     CA_FIELD_IDEAL_LENGTH(K) = 0;
     CA_FIELD_IDEAL_ALLOC(K) = 0;
     CA_FIELD_HASH(K) = 0;
+    K->refcount = 0;
+    K->owner = ctx;
+    K->gen = 0;
+    K->prec_hint = 0;
+    K->ideal_flags = 0;
 
     _ca_ctx_init_mctx(ctx, len);
 }
@@ -0,0 +1,159 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+/* Radicands larger than this are not factored. */
+#define MULTIQUADRATIC_MAX_BITS FLINT_BITS
+
+/* rank over GF(2) of the r x c matrix of bits A; destroys A */
+static slong
+_gf2_rank(unsigned char * A, slong r, slong c)
+{
+    slong i, j, k, pivot, rank;
+
+    rank = 0;
+
+    for (j = 0; j < c && rank < r; j++)
+    {
+        pivot = -1;
+        for (i = rank; i < r; i++)
+        {
+            if (A[i * c + j])
+            {
+                pivot = i;
+                break;
+            }
+        }
+
+        if (pivot == -1)
+            continue;
+
+        if (pivot != rank)
+        {
+            for (k = 0; k < c; k++)
+            {
+                unsigned char t = A[pivot * c + k];
+                A[pivot * c + k] = A[rank * c + k];
+                A[rank * c + k] = t;
+            }
+        }
+
+        for (i = rank + 1; i < r; i++)
+            if (A[i * c + j])
+                for (k = j; k < c; k++)
+                    A[i * c + k] ^= A[rank * c + k];
+
+        rank++;
+    }
+
+    return rank;
+}
+
+int
+ca_field_is_multiquadratic(const ca_field_t K, ca_ctx_t ctx)
+{
+    slong i, j, k, len, num_primes, alloc;
+    fmpz_factor_struct * fac;
+    fmpz * primes;
+    const fmpz * c;
+    unsigned char * A;
+    fmpz_t p;
+    int result;
+
+    if (!CA_FIELD_IS_GENERIC(K))
+        return 0;
+
+    len = CA_FIELD_LENGTH(K);
+
+    /* every generator must be a root of x^2 - p */
+    for (i = 0; i < len; i++)
+    {
+        if (!CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, i)))
+            return 0;
+
+        if (qqbar_degree(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))) != 2)
+            return 0;
+
+        c = QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i)));
+
+        if (!fmpz_is_zero(c + 1) || !fmpz_is_one(c + 2) || fmpz_bits(c) > MULTIQUADRATIC_MAX_BITS)
+            return 0;
+    }
+
+    /* The field has degree 2^len iff no nonempty product of radicands is
+       a square, i.e. iff the exponent vectors of the radicands modulo 2
+       (with the sign as an extra coordinate) are linearly independent. */
+    fac = flint_malloc(sizeof(fmpz_factor_struct) * len);
+    fmpz_init(p);
+
+    alloc = 1;
+    for (i = 0; i < len; i++)
+    {
+        fmpz_neg(p, QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))));
+        fmpz_factor_init(fac + i);
+        fmpz_factor(fac + i, p);
+        alloc += fac[i].num;
+    }
+
+    /* primes[0] = -1 stands for the sign */
+    primes = _fmpz_vec_init(alloc);
+    fmpz_set_si(primes, -1);
+    num_primes = 1;
+
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < fac[i].num; j++)
+        {
+            for (k = 1; k < num_primes; k++)
+                if (fmpz_equal(primes + k, fac[i].p + j))
+                    break;
+
+            if (k == num_primes)
+            {
+                fmpz_set(primes + k, fac[i].p + j);
+                num_primes++;
+            }
+        }
+    }
+
+    A = flint_calloc(len * num_primes, sizeof(unsigned char));
+
+    for (i = 0; i < len; i++)
+    {
+        if (fac[i].sign < 0)
+            A[i * num_primes] = 1;
+
+        for (j = 0; j < fac[i].num; j++)
+        {
+            for (k = 1; k < num_primes; k++)
+                if (fmpz_equal(primes + k, fac[i].p + j))
+                    break;
+
+            A[i * num_primes + k] = fac[i].exp[j] % 2;
+        }
+    }
+
+    result = (_gf2_rank(A, len, num_primes) == len);
+
+    flint_free(A);
+    _fmpz_vec_clear(primes, alloc);
+
+    for (i = 0; i < len; i++)
+        fmpz_factor_clear(fac + i);
+
+    flint_free(fac);
+    fmpz_clear(p);
+
+    return result;
+}
@@ -0,0 +1,141 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+/* Number of multipliers c to try for theta + c * a. All but finitely
+   many multipliers give a primitive element; in practice the first
+   one almost always works. */
+#define PRIMITIVE_MAX_TRIES 8
+
+/* Bound for the working precision needed to find x = p(alpha) by
+   qqbar_express_in_field. If x lies in Q(alpha), the denominator of p
+   divides lc(alpha)^d times the discriminant of alpha, whose size is
+   about 2 d times the height of alpha, and clearing it leaves integer
+   coefficients of comparable size. The integer relation found by LLL
+   has d + 2 entries, which needs about d + 2 times as many bits of
+   precision as the entries themselves. If no representation has been
+   found at this precision, x is (in practice) not in Q(alpha), and
+   doubling the precision further up to CA_OPT_PREC_LIMIT is wasted. */
+static slong
+_qqbar_express_prec_bound(const qqbar_t alpha, const qqbar_t x)
+{
+    slong d, bits;
+
+    d = qqbar_degree(alpha);
+
+    bits = 2 * d * (qqbar_height_bits(alpha) + FLINT_BIT_COUNT(d) + 1);
+    bits += qqbar_height_bits(x) + FLINT_BIT_COUNT(qqbar_degree(x));
+
+    return 64 + (d + 2) * bits;
+}
+
+static int
+_qqbar_express_in_field(fmpq_poly_t res, const qqbar_t alpha, const qqbar_t x, slong prec_limit)
+{
+    slong prec;
+
+    prec_limit = FLINT_MIN(prec_limit, _qqbar_express_prec_bound(alpha, x));
+
+    for (prec = 64; ; prec *= 2)
+    {
+        prec = FLINT_MIN(prec, prec_limit);
+
+        if (qqbar_express_in_field(res, alpha, x, prec, 0, prec))
+            return 1;
+
+        if (prec >= prec_limit)
+            return 0;
+    }
+}
+
+int
+ca_field_primitive_element(qqbar_t theta, fmpq_poly_struct * images,
+    const ca_field_t K, slong deg_limit, ca_ctx_t ctx)
+{
+    slong i, j, c, len, prec_limit;
+    qqbar_t t;
+    fmpq_poly_t p, m;
+    const qqbar_struct * a;
+    int found;
+
+    len = CA_FIELD_LENGTH(K);
+
+    if (len == 0 || CA_FIELD_IS_NF(K))
+        return 0;
+
+    for (i = 0; i < len; i++)
+        if (!CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, i)))
+            return 0;
+
+    if (qqbar_degree(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, 0))) > deg_limit)
+        return 0;
+
+    prec_limit = ctx->options[CA_OPT_PREC_LIMIT];
+
+    qqbar_init(t);
+    fmpq_poly_init(p);
+    fmpq_poly_init(m);
+
+    qqbar_set(theta, CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, 0)));
+    fmpq_poly_zero(images);
+    fmpq_poly_set_coeff_si(images, 1, 1);
+
+    found = 1;
+
+    for (i = 1; i < len && found; i++)
+    {
+        a = CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i));
+
+        /* a may already lie in Q(theta), e.g. a conjugate */
+        if (qqbar_degree(theta) % qqbar_degree(a) == 0 &&
+            _qqbar_express_in_field(images + i, theta, a, prec_limit))
+            continue;
+
+        found = 0;
+
+        for (c = 1; c <= PRIMITIVE_MAX_TRIES && !found; c++)
+        {
+            if (!qqbar_binop_within_limits(theta, a, deg_limit, 0))
+                break;
+
+            qqbar_mul_si(t, a, c);
+            qqbar_add(t, theta, t);
+
+            /* t = theta + c a is primitive iff theta = p(t) */
+            if (qqbar_degree(t) % qqbar_degree(theta) == 0 &&
+                _qqbar_express_in_field(p, t, theta, prec_limit))
+            {
+                fmpq_poly_set_fmpz_poly(m, QQBAR_POLY(t));
+
+                for (j = 0; j < i; j++)
+                    fmpq_poly_compose_mod(images + j, images + j, p, m);
+
+                /* a = (t - p(t)) / c */
+                fmpq_poly_zero(images + i);
+                fmpq_poly_set_coeff_si(images + i, 1, 1);
+                fmpq_poly_sub(images + i, images + i, p);
+                fmpq_poly_scalar_div_si(images + i, images + i, c);
+
+                qqbar_swap(theta, t);
+                found = 1;
+            }
+        }
+    }
+
+    qqbar_clear(t);
+    fmpq_poly_clear(p);
+    fmpq_poly_clear(m);
+
+    return found;
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_field.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("build_ideal....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_struct g[6];
+        ca_t x, y, t;
+        slong i, j, k;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(t, ctx);
+
+        for (i = 0; i < 6; i++)
+            ca_init(g + i, ctx);
+
+        /* log(2), log(3), log(6), sqrt(2), sqrt(3), sqrt(6) */
+        for (i = 0; i < 3; i++)
+        {
+            ca_set_ui(g + i, (i == 2) ? 6 : i + 2, ctx);
+            ca_sqrt(g + i + 3, g + i, ctx);
+            ca_log(g + i, g + i, ctx);
+        }
+
+        /* populate the cache with random subfields */
+        for (k = n_randint(state, 6); k > 0; k--)
+        {
+            i = n_randint(state, 6);
+            j = n_randint(state, 6);
+            ca_add(t, g + i, g + j, ctx);
+            if (n_randint(state, 2))
+            {
+                i = n_randint(state, 6);
+                ca_mul(t, t, g + i, ctx);
+            }
+        }
+
+        /* (log(2) + log(3)) sqrt(2) sqrt(3) - log(6) sqrt(6) = 0 */
+        if (n_randint(state, 2))
+        {
+            ca_add(x, g + 0, g + 1, ctx);
+            ca_mul(x, x, g + 3, ctx);
+            ca_mul(x, x, g + 4, ctx);
+        }
+        else
+        {
+            ca_mul(x, g + 3, g + 4, ctx);
+            ca_mul(t, x, g + 1, ctx);
+            ca_mul(x, x, g + 0, ctx);
+            ca_add(x, x, t, ctx);
+        }
+
+        ca_mul(y, g + 2, g + 5, ctx);
+        ca_sub(t, x, y, ctx);
+
+        if (ca_check_is_zero(t, ctx) != T_TRUE)
+        {
+            flint_printf("FAIL\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_printf("y = "); ca_print(y, ctx); flint_printf("\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < 6; i++)
+            ca_clear(g + i, ctx);
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(t, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
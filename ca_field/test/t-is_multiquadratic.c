@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_field.h"
+
+/* brute force: no nonempty product of the radicands is a square */
+static int
+_check_multiquadratic(const ca_field_t K, ca_ctx_t ctx)
+{
+    slong i, len;
+    ulong mask;
+    fmpz_t p;
+    int result;
+
+    if (!CA_FIELD_IS_GENERIC(K))
+        return 0;
+
+    len = CA_FIELD_LENGTH(K);
+
+    for (i = 0; i < len; i++)
+    {
+        if (!CA_EXT_IS_QQBAR(CA_FIELD_EXT_ELEM(K, i)) ||
+            qqbar_degree(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))) != 2 ||
+            !fmpz_is_zero(QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))) + 1) ||
+            !fmpz_is_one(QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))) + 2))
+            return 0;
+    }
+
+    fmpz_init(p);
+    result = 1;
+
+    for (mask = 1; mask < (UWORD(1) << len) && result; mask++)
+    {
+        fmpz_one(p);
+        for (i = 0; i < len; i++)
+        {
+            if ((mask >> i) & 1)
+            {
+                fmpz_mul(p, p, QQBAR_COEFFS(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i))));
+                fmpz_neg(p, p);
+            }
+        }
+
+        result = !fmpz_is_square(p);
+    }
+
+    fmpz_clear(p);
+    return result;
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("is_multiquadratic....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_struct g[4];
+        qqbar_struct h[4];
+        ca_t x, y, t;
+        qqbar_t a, b, c;
+        slong i, n, k;
+
+        ca_ctx_init(ctx);
+        ca_init(x, ctx);
+        ca_init(y, ctx);
+        ca_init(t, ctx);
+        qqbar_init(a);
+        qqbar_init(b);
+        qqbar_init(c);
+
+        n = 1 + n_randint(state, 4);
+
+        for (i = 0; i < n; i++)
+        {
+            ca_init(g + i, ctx);
+            qqbar_init(h + i);
+
+            do {
+                k = (slong) n_randint(state, 21) - 10;
+            } while (k == 0);
+
+            ca_set_si(g + i, k, ctx);
+            ca_sqrt(g + i, g + i, ctx);
+            qqbar_set_si(h + i, k);
+            qqbar_sqrt(h + i, h + i);
+        }
+
+        /* x = sum of c_i sqrt(k_i), y = prod of (sqrt(k_i) + d_i) */
+        ca_zero(x, ctx);
+        qqbar_zero(a);
+        ca_one(y, ctx);
+        qqbar_one(b);
+
+        for (i = 0; i < n; i++)
+        {
+            k = (slong) n_randint(state, 7) - 3;
+            ca_mul_si(t, g + i, k, ctx);
+            ca_add(x, x, t, ctx);
+            qqbar_mul_si(c, h + i, k);
+            qqbar_add(a, a, c);
+
+            k = (slong) n_randint(state, 7) - 3;
+            ca_add_si(t, g + i, k, ctx);
+            ca_mul(y, y, t, ctx);
+            qqbar_add_si(c, h + i, k);
+            qqbar_mul(b, b, c);
+        }
+
+        if (n_randint(state, 2) && !qqbar_is_zero(b))
+        {
+            ca_div(t, x, y, ctx);
+            qqbar_div(c, a, b);
+        }
+        else
+        {
+            ca_mul(t, x, y, ctx);
+            qqbar_mul(c, a, b);
+        }
+
+        if (!CA_IS_SPECIAL(t) && _check_multiquadratic(CA_FIELD(t, ctx), ctx) != ca_field_is_multiquadratic(CA_FIELD(t, ctx), ctx))
+        {
+            flint_printf("FAIL (is_multiquadratic)\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* compare with qqbar arithmetic and check exact zero testing */
+        ca_set_qqbar(x, c, ctx);
+        ca_sub(x, x, t, ctx);
+
+        if (ca_check_is_zero(x, ctx) != T_TRUE || ca_is_zero_check_fast(t, ctx) == (qqbar_is_zero(c) ? T_FALSE : T_TRUE))
+        {
+            flint_printf("FAIL (zero test)\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n");
+            flint_printf("c = "); qqbar_print(c); flint_printf("\n");
+            flint_printf("x = "); ca_print(x, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            ca_clear(g + i, ctx);
+            qqbar_clear(h + i);
+        }
+
+        ca_clear(x, ctx);
+        ca_clear(y, ctx);
+        ca_clear(t, ctx);
+        qqbar_clear(a);
+        qqbar_clear(b);
+        qqbar_clear(c);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca.h"
+#include "ca_ext.h"
+#include "ca_field.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("primitive_element....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        qqbar_struct a[3];
+        ca_struct x[3];
+        ca_struct y[3];
+        qqbar_t theta, s, t;
+        fmpq_poly_struct * images;
+        ca_field_srcptr K;
+        ca_t z;
+        slong i, len;
+
+        ca_ctx_init(ctx);
+        ca_ctx_set_option(ctx, CA_OPT_PRIMITIVE_DEG_LIMIT, n_randint(state, 2) ? 0 : 16);
+        ca_ctx_set_option(ctx, CA_OPT_PRIMITIVE_CACHE_SIZE, n_randint(state, 4) ? 64 : 0);
+
+        qqbar_init(theta);
+        qqbar_init(s);
+        qqbar_init(t);
+        ca_init(z, ctx);
+
+        for (i = 0; i < 3; i++)
+        {
+            qqbar_init(a + i);
+            ca_init(x + i, ctx);
+            ca_init(y + i, ctx);
+
+            do {
+                qqbar_randtest(a + i, state, 2, 4);
+            } while (qqbar_degree(a + i) < 2);
+
+            ca_set_qqbar(x + i, a + i, ctx);
+        }
+
+        /* the generators are recovered from the images */
+        K = _ca_merge_fields_vec(y, x, 3, ctx);
+        len = CA_FIELD_LENGTH(K);
+
+        if (CA_FIELD_IS_GENERIC(K))
+        {
+            images = flint_malloc(sizeof(fmpq_poly_struct) * len);
+            for (i = 0; i < len; i++)
+                fmpq_poly_init(images + i);
+
+            if (ca_field_primitive_element(theta, images, K, 64, ctx))
+            {
+                for (i = 0; i < len; i++)
+                {
+                    if (!qqbar_equal_fmpq_poly_val(CA_EXT_QQBAR(CA_FIELD_EXT_ELEM(K, i)), images + i, theta))
+                    {
+                        flint_printf("FAIL (images)\n");
+                        flint_printf("K = "); ca_field_print(K, ctx); flint_printf("\n");
+                        flint_printf("theta = "); qqbar_print(theta); flint_printf("\n");
+                        flint_printf("i = %wd, image = ", i); fmpq_poly_print(images + i); flint_printf("\n");
+                        flint_abort();
+                    }
+                }
+            }
+
+            for (i = 0; i < len; i++)
+                fmpq_poly_clear(images + i);
+            flint_free(images);
+        }
+
+        /* arithmetic through merged fields */
+        ca_add(z, x + 0, x + 1, ctx);
+        ca_mul(z, z, x + 2, ctx);
+        ca_sub(z, z, x + 1, ctx);
+
+        qqbar_add(s, a + 0, a + 1);
+        qqbar_mul(s, s, a + 2);
+        qqbar_sub(s, s, a + 1);
+
+        if (!ca_get_qqbar(t, z, ctx) || !qqbar_equal(s, t))
+        {
+            flint_printf("FAIL (arithmetic)\n");
+            flint_printf("z = "); ca_print(z, ctx); flint_printf("\n");
+            flint_printf("s = "); qqbar_print(s); flint_printf("\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < 3; i++)
+        {
+            qqbar_clear(a + i);
+            ca_clear(x + i, ctx);
+            ca_clear(y + i, ctx);
+        }
+
+        qqbar_clear(theta);
+        qqbar_clear(s);
+        qqbar_clear(t);
+        ca_clear(z, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -103,6 +103,8 @@ void ca_mat_set_fmpz_mat(ca_mat_t dest, const fmpz_mat_t src, ca_ctx_t ctx);
 void ca_mat_set_fmpq_mat(ca_mat_t dest, const fmpq_mat_t src, ca_ctx_t ctx);
 void ca_mat_set_ca(ca_mat_t y, const ca_t x, ca_ctx_t ctx);
 
+void ca_mat_get_acb_raw(acb_mat_t res, const ca_mat_t A, slong prec, ca_ctx_t ctx);
+
 void ca_mat_transfer(ca_mat_t res, ca_ctx_t res_ctx, const ca_mat_t src, ca_ctx_t src_ctx);
 
 /* Random generation */
@@ -15,7 +15,7 @@ void
 ca_mat_dft(ca_mat_t res, int type, ca_ctx_t ctx)
 {
     ca_ptr w;
-    slong n, r, c, i, j;
+    slong n, r, c, i, j, e;
 
     r = ca_mat_nrows(res);
     c = ca_mat_ncols(res);
@@ -24,9 +24,11 @@ ca_mat_dft(ca_mat_t res, int type, ca_ctx_t ctx)
     if (n == 0)
         return;
 
-    w = _ca_vec_init(2 * n, ctx);
+    /* The entries only take the n distinct values w^k, which are
+       computed (and normalized) once in the cyclotomic field. */
+    w = _ca_vec_init(n, ctx);
 
-    for (i = 0; i < 2 * n; i++)
+    for (i = 0; i < n; i++)
     {
         if (i == 0)
         {
@@ -47,21 +49,10 @@ ca_mat_dft(ca_mat_t res, int type, ca_ctx_t ctx)
         }
     }
 
-    for (i = 0; i < r; i++)
-    {
-        for (j = 0; j < c; j++)
-        {
-            ca_set(ca_mat_entry(res, i, j), w + (i * j) % (2 * n), ctx);
-        }
-    }
-
-    _ca_vec_clear(w, 2 * n, ctx);
-
     if (type == 1)
     {
-        for (i = 0; i < r; i++)
-            for (j = 0; j < c; j++)
-                ca_div_ui(ca_mat_entry(res, i, j), ca_mat_entry(res, i, j), n, ctx);
+        for (i = 0; i < n; i++)
+            ca_div_ui(w + i, w + i, n, ctx);
     }
     else if (type == 2 || type == 3)
     {
@@ -71,10 +62,23 @@ ca_mat_dft(ca_mat_t res, int type, ca_ctx_t ctx)
         ca_sqrt_ui(t, n, ctx);
         ca_inv(t, t, ctx);
 
-        for (i = 0; i < r; i++)
-            for (j = 0; j < c; j++)
-                ca_mul(ca_mat_entry(res, i, j), ca_mat_entry(res, i, j), t, ctx);
+        for (i = 0; i < n; i++)
+            ca_mul(w + i, w + i, t, ctx);
 
         ca_clear(t, ctx);
     }
+
+    for (i = 0; i < r; i++)
+    {
+        /* e = i j mod n */
+        for (j = 0, e = 0; j < c; j++)
+        {
+            ca_set(ca_mat_entry(res, i, j), w + e, ctx);
+            e += i % n;
+            if (e >= n)
+                e -= n;
+        }
+    }
+
+    _ca_vec_clear(w, n, ctx);
 }
@@ -0,0 +1,44 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_mat.h"
+
+void
+ca_mat_get_acb_raw(acb_mat_t res, const ca_mat_t A, slong prec, ca_ctx_t ctx)
+{
+    ca_ptr t;
+    acb_ptr v;
+    slong i, j, r, c;
+
+    r = ca_mat_nrows(A);
+    c = ca_mat_ncols(A);
+
+    if (r == 0 || c == 0)
+        return;
+
+    /* Shallow copies, so that the generators shared between
+       rows are evaluated only once even if A is a window. */
+    t = flint_malloc(sizeof(ca_struct) * r * c);
+    v = _acb_vec_init(r * c);
+
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++)
+            t[i * c + j] = *ca_mat_entry(A, i, j);
+
+    _ca_vec_get_acb_raw(v, t, r * c, prec, ctx);
+
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++)
+            acb_swap(acb_mat_entry(res, i, j), v + i * c + j);
+
+    _acb_vec_clear(v, r * c);
+    flint_free(t);
+}
@@ -15,7 +15,7 @@ void
 ca_mat_mul_classical(ca_mat_t C, const ca_mat_t A, const ca_mat_t B, ca_ctx_t ctx)
 {
     slong ar, ac, br, bc, i, j, k;
-    ca_t t;
+    ca_struct * t;
 
     ar = ca_mat_nrows(A);
     ac = ca_mat_ncols(A);
@@ -44,23 +44,18 @@ ca_mat_mul_classical(ca_mat_t C, const ca_mat_t A, const ca_mat_t B, ca_ctx_t ct
         return;
     }
 
-    ca_init(t, ctx);
+    /* shallow copy of a column of B, so that ca_dot can read it
+       with unit stride */
+    t = flint_malloc(sizeof(ca_struct) * br);
 
-    for (i = 0; i < ar; i++)
+    for (j = 0; j < bc; j++)
     {
-        for (j = 0; j < bc; j++)
-        {
-            ca_mul(ca_mat_entry(C, i, j),
-                      ca_mat_entry(A, i, 0),
-                      ca_mat_entry(B, 0, j), ctx);
+        for (k = 0; k < br; k++)
+            t[k] = *ca_mat_entry(B, k, j);
 
-            for (k = 1; k < br; k++)
-            {
-                ca_mul(t, ca_mat_entry(A, i, k), ca_mat_entry(B, k, j), ctx);
-                ca_add(ca_mat_entry(C, i, j), ca_mat_entry(C, i, j), t, ctx);
-            }
-        }
+        for (i = 0; i < ar; i++)
+            ca_dot(ca_mat_entry(C, i, j), NULL, 0, ca_mat_entry(A, i, 0), 1, t, 1, br, ctx);
     }
 
-    ca_clear(t, ctx);
+    flint_free(t);
 }
@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_mat.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("get_acb_raw....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_mat_t A;
+        acb_mat_t B;
+        acb_t t;
+        slong i, j, M, N, prec;
+
+        M = n_randint(state, 4);
+        N = n_randint(state, 4);
+        prec = 2 + n_randint(state, 200);
+
+        ca_ctx_init(ctx);
+
+        if (n_randint(state, 2))
+            ca_ctx_set_option(ctx, CA_OPT_ACB_CACHE_SIZE, 0);
+
+        ca_mat_init(A, M, N, ctx);
+        acb_mat_init(B, M, N);
+        acb_init(t);
+
+        ca_mat_randtest(A, state, 2, 10, ctx);
+        ca_mat_get_acb_raw(B, A, prec, ctx);
+
+        for (i = 0; i < M; i++)
+        {
+            for (j = 0; j < N; j++)
+            {
+                ca_get_acb_raw(t, ca_mat_entry(A, i, j), prec, ctx);
+
+                if (!acb_overlaps(t, acb_mat_entry(B, i, j)))
+                {
+                    flint_printf("FAIL\n");
+                    flint_printf("A = "); ca_mat_print(A, ctx); flint_printf("\n");
+                    flint_printf("B = "); acb_mat_printd(B, 10); flint_printf("\n");
+                    flint_printf("i, j = %wd, %wd\n", i, j);
+                    flint_abort();
+                }
+            }
+        }
+
+        ca_mat_clear(A, ctx);
+        acb_mat_clear(B);
+        acb_clear(t);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -14,7 +14,7 @@
 void
 ca_mat_transfer(ca_mat_t res, ca_ctx_t res_ctx, const ca_mat_t src, ca_ctx_t src_ctx)
 {
-    slong i, j;
+    slong i;
 
     if (res_ctx == src_ctx)
     {
@@ -22,8 +22,8 @@ ca_mat_transfer(ca_mat_t res, ca_ctx_t res_ctx, const ca_mat_t src, ca_ctx_t src
     }
     else
     {
-        for (i = 0; i < ca_mat_nrows(src); i++)
-            for (j = 0; j < ca_mat_ncols(src); j++)
-                ca_transfer(ca_mat_entry(res, i, j), res_ctx, ca_mat_entry(src, i, j), src_ctx);
+        if (ca_mat_ncols(src) != 0)
+            for (i = 0; i < ca_mat_nrows(src); i++)
+                _ca_vec_transfer(ca_mat_entry(res, i, 0), res_ctx, ca_mat_entry(src, i, 0), src_ctx, ca_mat_ncols(src));
     }
 }
@@ -55,23 +55,13 @@ _ca_vec_same_field2(ca_srcptr A, slong Alen, ca_srcptr B, slong Blen, ca_ctx_t c
     return K;
 }
 
-static void
-_ca_addmul(ca_t x, ca_t tmp, const ca_t a, const ca_t b, ca_ctx_t ctx)
-{
-    ca_mul(tmp, a, b, ctx);
-    ca_add(x, x, tmp, ctx);
-}
-
 static void
 _ca_poly_sqrlow_classical(ca_ptr res, ca_srcptr poly1, slong len1,
     slong n, ca_ctx_t ctx)
 {
     slong i, start, stop;
-    ca_t t;
 
     /* Basecase squaring */
-    ca_init(t, ctx);
-
     ca_sqr(res, poly1, ctx);
     ca_mul(res + 1, poly1, poly1 + 1, ctx);
     ca_mul_ui(res + 1, res + 1, 2, ctx);
@@ -85,7 +75,7 @@ _ca_poly_sqrlow_classical(ca_ptr res, ca_srcptr poly1, slong len1,
             poly1 + i - start, -1, stop - start + 1, ctx);
         ca_mul_ui(res + i, res + i, 2, ctx);
         if (i % 2 == 0 && i / 2 < len1)
-            _ca_addmul(res + i, t, poly1 + i / 2, poly1 + i / 2, ctx);
+            ca_addmul(res + i, poly1 + i / 2, poly1 + i / 2, ctx);
     }
 
     if (len1 > 2 && n >= 2 * len1 - 2)
@@ -96,8 +86,6 @@ _ca_poly_sqrlow_classical(ca_ptr res, ca_srcptr poly1, slong len1,
 
     if (n >= 2 * len1 - 1)
         ca_sqr(res + 2 * len1 - 2, poly1 + len1 - 1, ctx);
-
-    ca_clear(t, ctx);
 }
 
 static void
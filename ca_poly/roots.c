@@ -38,15 +38,15 @@ _ca_poly_roots_quadratic(ca_t r1, ca_t r2, const ca_t a, const ca_t b, const ca_
     ca_clear(t, ctx);
 }
 
-/* exp(2 pi i * (1 / 3)) */
-/* todo: make this faster to construct */
+/* exp(2 pi i * (1 / 3)), constructed directly in Q(zeta_3) */
 void
 ca_omega(ca_t res, ca_ctx_t ctx)
 {
-    ca_pi_i(res, ctx);
-    ca_mul_ui(res, res, 2, ctx);
-    ca_div_ui(res, res, 3, ctx);
-    ca_exp(res, res, ctx);
+    qqbar_t t;
+    qqbar_init(t);
+    qqbar_root_of_unity(t, 1, 3);
+    ca_set_qqbar(res, t, ctx);
+    qqbar_clear(t);
 }
 
 /* Solves a cubic equation using the cubic formula.
@@ -14,7 +14,7 @@
 void
 ca_poly_transfer(ca_poly_t res, ca_ctx_t res_ctx, const ca_poly_t src, ca_ctx_t src_ctx)
 {
-    slong i, len;
+    slong len;
 
     if (res_ctx == src_ctx)
     {
@@ -27,8 +27,7 @@ ca_poly_transfer(ca_poly_t res, ca_ctx_t res_ctx, const ca_poly_t src, ca_ctx_t
         ca_poly_fit_length(res, len, res_ctx);
         _ca_poly_set_length(res, len, res_ctx);
 
-        for (i = 0; i < src->length; i++)
-            ca_transfer(res->coeffs + i, res_ctx, src->coeffs + i, src_ctx);
+        _ca_vec_transfer(res->coeffs, res_ctx, src->coeffs, src_ctx, len);
 
         _ca_poly_normalise(res, res_ctx);
     }
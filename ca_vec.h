@@ -86,6 +86,12 @@ void ca_vec_set_length(ca_vec_t res, slong len, ca_ctx_t ctx);
 void _ca_vec_set(ca_ptr res, ca_srcptr src, slong len, ca_ctx_t ctx);
 void ca_vec_set(ca_vec_t res, const ca_vec_t src, ca_ctx_t ctx);
 
+void _ca_vec_get_acb_raw(acb_ptr res, ca_srcptr x, slong len, slong prec, ca_ctx_t ctx);
+void ca_vec_get_acb_raw(acb_ptr res, const ca_vec_t x, slong prec, ca_ctx_t ctx);
+
+void _ca_vec_transfer(ca_ptr res, ca_ctx_t res_ctx, ca_srcptr src, ca_ctx_t src_ctx, slong len);
+void ca_vec_transfer(ca_vec_t res, ca_ctx_t res_ctx, const ca_vec_t src, ca_ctx_t src_ctx);
+
 /* Special vectors */
 
 void _ca_vec_zero(ca_ptr res, slong len, ca_ctx_t ctx);
@@ -134,6 +140,13 @@ void _ca_vec_scalar_div_ca(ca_ptr res, ca_srcptr src, slong len, const ca_t c, c
 void _ca_vec_scalar_addmul_ca(ca_ptr res, ca_srcptr vec, slong len, const ca_t c, ca_ctx_t ctx);
 void _ca_vec_scalar_submul_ca(ca_ptr res, ca_srcptr vec, slong len, const ca_t c, ca_ctx_t ctx);
 
+ca_field_srcptr _ca_vec_lift_common_field(ca_ptr res, ca_srcptr vec, slong len, ca_ctx_t ctx);
+
+void _ca_vec_sum(ca_t res, ca_srcptr vec, slong len, ca_ctx_t ctx);
+void ca_vec_sum(ca_t res, const ca_vec_t vec, ca_ctx_t ctx);
+void _ca_vec_prod(ca_t res, ca_srcptr vec, slong len, ca_ctx_t ctx);
+void ca_vec_prod(ca_t res, const ca_vec_t vec, ca_ctx_t ctx);
+
 /* Comparisons and predicates */
 
 truth_t _ca_vec_check_is_zero(ca_srcptr vec, slong len, ca_ctx_t ctx);
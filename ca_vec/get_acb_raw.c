@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+#include "ca_ext.h"
+
+static slong
+_ptr_index(const void ** ptrs, slong len, const void * p)
+{
+    slong i;
+
+    for (i = len - 1; i >= 0; i--)
+        if (ptrs[i] == p)
+            return i;
+
+    return -1;
+}
+
+void
+_ca_vec_get_acb_raw(acb_ptr res, ca_srcptr x, slong len, slong prec, ca_ctx_t ctx)
+{
+    const void ** fields;
+    const void ** exts;
+    acb_ptr * field_gens;
+    acb_ptr ext_vals;
+    slong * field_index;
+    ulong * hashes;
+    slong i, j, k, e, num_fields, num_exts, alloc_exts;
+    ca_field_srcptr K;
+    int memo;
+
+    if (len == 0)
+        return;
+
+    memo = (ctx->options[CA_OPT_ACB_CACHE_SIZE] > 0);
+
+    fields = flint_malloc(sizeof(void *) * len);
+    field_index = flint_malloc(sizeof(slong) * len);
+    hashes = flint_malloc(sizeof(ulong) * len);
+    num_fields = 0;
+
+    /* Rational elements and memoized values are done directly;
+       group the remaining elements by field. */
+    for (i = 0; i < len; i++)
+    {
+        field_index[i] = -1;
+
+        if (CA_IS_SPECIAL(x + i) || CA_IS_QQ(x + i, ctx) || CA_IS_QQ_I(x + i, ctx))
+        {
+            ca_get_acb_raw(res + i, x + i, prec, ctx);
+            continue;
+        }
+
+        K = CA_FIELD(x + i, ctx);
+
+        if (memo && CA_FIELD_IS_GENERIC(K))
+        {
+            hashes[i] = ca_hash_repr(x + i, ctx);
+
+            if (_ca_ctx_acb_cache_lookup(res + i, x + i, hashes[i], prec, ctx))
+                continue;
+        }
+
+        k = _ptr_index(fields, num_fields, K);
+
+        if (k == -1)
+        {
+            k = num_fields;
+            fields[num_fields++] = K;
+        }
+
+        field_index[i] = k;
+    }
+
+    /* Evaluate each distinct generator once. */
+    alloc_exts = 0;
+    for (k = 0; k < num_fields; k++)
+        alloc_exts += CA_FIELD_LENGTH((ca_field_srcptr) fields[k]);
+    alloc_exts = FLINT_MAX(alloc_exts, 1);
+
+    exts = flint_malloc(sizeof(void *) * alloc_exts);
+    ext_vals = _acb_vec_init(alloc_exts);
+    field_gens = flint_malloc(sizeof(acb_ptr) * FLINT_MAX(num_fields, 1));
+    num_exts = 0;
+
+    for (k = 0; k < num_fields; k++)
+    {
+        K = fields[k];
+        field_gens[k] = _acb_vec_init(CA_FIELD_LENGTH(K));
+
+        for (j = 0; j < CA_FIELD_LENGTH(K); j++)
+        {
+            e = _ptr_index(exts, num_exts, CA_FIELD_EXT_ELEM(K, j));
+
+            if (e == -1)
+            {
+                e = num_exts;
+                exts[num_exts++] = CA_FIELD_EXT_ELEM(K, j);
+                ca_ext_get_acb_raw(ext_vals + e, CA_FIELD_EXT_ELEM(K, j), prec, ctx);
+            }
+
+            acb_set(field_gens[k] + j, ext_vals + e);
+        }
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if (field_index[i] == -1)
+            continue;
+
+        _ca_get_acb_raw_gens(res + i, x + i, field_gens[field_index[i]], prec, ctx);
+
+        if (memo && CA_FIELD_IS_GENERIC(CA_FIELD(x + i, ctx)))
+            _ca_ctx_acb_cache_insert(x + i, hashes[i], res + i, prec, ctx);
+    }
+
+    for (k = 0; k < num_fields; k++)
+        _acb_vec_clear(field_gens[k], CA_FIELD_LENGTH((ca_field_srcptr) fields[k]));
+
+    _acb_vec_clear(ext_vals, alloc_exts);
+    flint_free(field_gens);
+    flint_free(exts);
+    flint_free(hashes);
+    flint_free(field_index);
+    flint_free(fields);
+}
+
+void
+ca_vec_get_acb_raw(acb_ptr res, const ca_vec_t x, slong prec, ca_ctx_t ctx)
+{
+    _ca_vec_get_acb_raw(res, x->entries, x->length, prec, ctx);
+}
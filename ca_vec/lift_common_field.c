@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+
+ca_field_srcptr
+_ca_vec_lift_common_field(ca_ptr res, ca_srcptr vec, slong len, ca_ctx_t ctx)
+{
+    ca_field_srcptr K, field;
+    slong i;
+    int generic;
+
+    K = ctx->field_qq;
+    generic = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        if (CA_IS_SPECIAL(vec + i))
+            return NULL;
+
+        field = CA_FIELD(vec + i, ctx);
+
+        if (CA_FIELD_IS_QQ(field))
+            continue;
+
+        if (CA_FIELD_IS_GENERIC(field) || (K != ctx->field_qq && K != field))
+            generic = 1;
+
+        K = field;
+    }
+
+    /* arithmetic in a single number field needs no merging or ideal reduction */
+    if (!generic)
+        return NULL;
+
+    K = _ca_merge_fields_vec(res, vec, len, ctx);
+
+    if (!CA_FIELD_IS_GENERIC(K))
+        flint_abort();
+
+    return K;
+}
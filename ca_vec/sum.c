@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+
+static void
+_fmpz_mpoly_q_sum_bsplit(fmpz_mpoly_q_t res, ca_srcptr vec, slong a, slong b, const fmpz_mpoly_ctx_t mctx)
+{
+    if (b - a == 1)
+    {
+        fmpz_mpoly_q_set(res, CA_MPOLY_Q(vec + a), mctx);
+    }
+    else if (b - a == 2)
+    {
+        fmpz_mpoly_q_add(res, CA_MPOLY_Q(vec + a), CA_MPOLY_Q(vec + a + 1), mctx);
+    }
+    else
+    {
+        fmpz_mpoly_q_t t;
+        slong m = a + (b - a) / 2;
+
+        fmpz_mpoly_q_init(t, mctx);
+        _fmpz_mpoly_q_sum_bsplit(res, vec, a, m, mctx);
+        _fmpz_mpoly_q_sum_bsplit(t, vec, m, b, mctx);
+        fmpz_mpoly_q_add(res, res, t, mctx);
+        fmpz_mpoly_q_clear(t, mctx);
+    }
+}
+
+void
+_ca_vec_sum(ca_t res, ca_srcptr vec, slong len, ca_ctx_t ctx)
+{
+    ca_field_srcptr K;
+    ca_ptr t;
+    slong i;
+
+    if (len <= 2)
+    {
+        if (len == 0)
+            ca_zero(res, ctx);
+        else if (len == 1)
+            ca_set(res, vec, ctx);
+        else
+            ca_add(res, vec, vec + 1, ctx);
+        return;
+    }
+
+    t = _ca_vec_init(len, ctx);
+
+    K = _ca_vec_lift_common_field(t, vec, len, ctx);
+
+    if (K == NULL)
+    {
+        ca_add(t, vec, vec + 1, ctx);
+        for (i = 2; i < len; i++)
+            ca_add(t, t, vec + i, ctx);
+        ca_swap(res, t, ctx);
+    }
+    else
+    {
+        /* balanced sum of the lifted fractions; the ideal
+           reduction and condensation are done only once */
+        _ca_make_field_element(res, K, ctx);
+        _fmpz_mpoly_q_sum_bsplit(CA_MPOLY_Q(res), t, 0, len, CA_FIELD_MCTX(K, ctx));
+        _ca_mpoly_q_reduce_ideal(CA_MPOLY_Q(res), K, ctx);
+        _ca_mpoly_q_simplify_fraction_ideal(CA_MPOLY_Q(res), K, ctx);
+        ca_condense_field(res, ctx);
+    }
+
+    _ca_vec_clear(t, len, ctx);
+}
+
+void
+ca_vec_sum(ca_t res, const ca_vec_t vec, ca_ctx_t ctx)
+{
+    _ca_vec_sum(res, vec->entries, vec->length, ctx);
+}
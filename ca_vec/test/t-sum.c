@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("sum....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 500 * calcium_test_multiplier(); iter++)
+    {
+        ca_ctx_t ctx;
+        ca_ptr vec;
+        ca_t s, t;
+        slong i, len;
+        ulong r;
+        int alias, ok;
+
+        ca_ctx_init(ctx);
+
+        len = n_randint(state, 7);
+        vec = _ca_vec_init(len, ctx);
+        ca_init(s, ctx);
+        ca_init(t, ctx);
+
+        for (i = 0; i < len; i++)
+        {
+            r = n_randint(state, 8);
+
+            if (r == 0)
+            {
+                ca_randtest_special(vec + i, state, 2, 10, ctx);
+            }
+            else if (r == 1)
+            {
+                ca_randtest_rational(vec + i, state, 10, ctx);
+            }
+            else if (r == 2 && i > 0)
+            {
+                /* share a field with an earlier entry */
+                ca_randtest_rational(s, state, 10, ctx);
+                ca_mul(vec + i, vec + n_randint(state, i), s, ctx);
+            }
+            else
+            {
+                ca_randtest(vec + i, state, 2, 10, ctx);
+            }
+        }
+
+        if (len == 0)
+        {
+            ca_zero(t, ctx);
+        }
+        else
+        {
+            ca_set(t, vec, ctx);
+            for (i = 1; i < len; i++)
+                ca_add(t, t, vec + i, ctx);
+        }
+
+        alias = (len != 0) && n_randint(state, 2);
+
+        if (alias)
+        {
+            _ca_vec_sum(vec, vec, len, ctx);
+            ca_set(s, vec, ctx);
+        }
+        else
+        {
+            _ca_vec_sum(s, vec, len, ctx);
+        }
+
+        if (CA_IS_SPECIAL(s) || CA_IS_SPECIAL(t))
+            ok = ca_equal_repr(s, t, ctx);
+        else
+            ok = (ca_check_equal(s, t, ctx) != T_FALSE);
+
+        if (!ok)
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("len = %wd, alias = %d\n\n", len, alias);
+            flint_printf("s = "); ca_print(s, ctx); flint_printf("\n\n");
+            flint_printf("t = "); ca_print(t, ctx); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        _ca_vec_clear(vec, len, ctx);
+        ca_clear(s, ctx);
+        ca_clear(t, ctx);
+        ca_ctx_clear(ctx);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
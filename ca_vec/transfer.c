@@ -0,0 +1,44 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "ca_vec.h"
+
+void
+_ca_vec_transfer(ca_ptr res, ca_ctx_t res_ctx, ca_srcptr src, ca_ctx_t src_ctx, slong len)
+{
+    ca_transfer_table_struct * T;
+    slong i;
+
+    if (res_ctx == src_ctx)
+    {
+        _ca_vec_set(res, src, len, res_ctx);
+        return;
+    }
+
+    /* see ca_transfer */
+    ca_ctx_lock(res_ctx);
+    res_ctx->cache_depth++;
+
+    T = _ca_ctx_transfer_table(res_ctx, src_ctx);
+
+    for (i = 0; i < len; i++)
+        _ca_transfer(res + i, res_ctx, src + i, src_ctx, T);
+
+    res_ctx->cache_depth--;
+    ca_ctx_unlock(res_ctx);
+}
+
+void
+ca_vec_transfer(ca_vec_t res, ca_ctx_t res_ctx, const ca_vec_t src, ca_ctx_t src_ctx)
+{
+    ca_vec_set_length(res, ca_vec_length(src, src_ctx), res_ctx);
+    _ca_vec_transfer(ca_vec_entry(res, 0), res_ctx, ca_vec_entry(src, 0), src_ctx, ca_vec_length(res, res_ctx));
+}
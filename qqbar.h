@@ -454,14 +454,43 @@ int qqbar_get_fexpr_formula(fexpr_t res, const qqbar_t x, ulong flags);
 
 int qqbar_set_fexpr(qqbar_t res, const fexpr_t expr);
 
+/* Statistics */
+
+typedef struct
+{
+    slong composed_ops;          /* Number of composed operations        */
+    slong composed_degree;       /* Sum of the degrees of the resultants */
+    slong composed_max_degree;   /* Largest degree of a resultant        */
+    double factor_time;          /* Seconds spent factoring resultants   */
+    slong composed_cache_hits;   /* Factorizations found in the memo     */
+    slong composed_cache_misses;
+}
+qqbar_stats_struct;
+
+typedef qqbar_stats_struct qqbar_stats_t[1];
+
+/* one set of counters per thread */
+extern FLINT_TLS_PREFIX qqbar_stats_struct _qqbar_stats;
+
+void qqbar_stats_get(qqbar_stats_t stats);
+void qqbar_stats_reset(void);
+
+void qqbar_composed_cache_clear(void);
+
 /* Internal functions */
 
 void qqbar_scalar_op(qqbar_t res, const qqbar_t x, const fmpz_t a, const fmpz_t b, const fmpz_t c);
 
 void qqbar_fmpz_poly_composed_op(fmpz_poly_t res, const fmpz_poly_t A, const fmpz_poly_t B, int op);
 
+void _qqbar_fmpz_poly_composed_op_multimod(fmpz_poly_t res, const fmpz_poly_t A, const fmpz_poly_t B, int op);
+
 void qqbar_binary_op(qqbar_t res, const qqbar_t x, const qqbar_t y, int op);
 
+int _qqbar_composed_cache_lookup(fmpz_poly_factor_t fac, const fmpz_poly_t A, const fmpz_poly_t B, int op);
+
+void _qqbar_composed_cache_insert(const fmpz_poly_t A, const fmpz_poly_t B, int op, const fmpz_poly_factor_t fac);
+
 int _qqbar_validate_uniqueness(acb_t res, const fmpz_poly_t poly, const acb_t z, slong max_prec);
 
 int _qqbar_validate_existence_uniqueness(acb_t res, const fmpz_poly_t poly, const acb_t z, slong prec);
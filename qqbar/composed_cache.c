@@ -0,0 +1,146 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "qqbar.h"
+
+/* Per-thread memo of factored composed polynomials, keyed by the pair of
+   minimal polynomials and the operation. Direct-mapped: a new entry
+   evicts whatever was stored in its slot. */
+
+#define QQBAR_COMPOSED_CACHE_SIZE 64
+
+typedef struct
+{
+    fmpz_poly_struct A;
+    fmpz_poly_struct B;
+    int op;
+    int used;
+    fmpz_poly_factor_struct fac;
+}
+qqbar_composed_cache_entry;
+
+static FLINT_TLS_PREFIX qqbar_composed_cache_entry * _qqbar_composed_cache = NULL;
+
+static ulong
+_fmpz_poly_hash(const fmpz_poly_t A)
+{
+    ulong s;
+    slong i;
+
+    s = 1234567;
+    for (i = 0; i < A->length; i++)
+        s = calcium_fmpz_hash(A->coeffs + i) * 1000003 + s;
+
+    return s;
+}
+
+/* Addition and multiplication are symmetric: order the key by hash. */
+static ulong
+_qqbar_composed_cache_key(const fmpz_poly_struct ** A, const fmpz_poly_struct ** B, int op)
+{
+    ulong ha, hb;
+    const fmpz_poly_struct * t;
+
+    ha = _fmpz_poly_hash(*A);
+    hb = _fmpz_poly_hash(*B);
+
+    if ((op == 0 || op == 2) && ha > hb)
+    {
+        t = *A;
+        *A = *B;
+        *B = t;
+        return hb * 1000003 + ha * 31 + op;
+    }
+
+    return ha * 1000003 + hb * 31 + op;
+}
+
+void
+qqbar_composed_cache_clear(void)
+{
+    slong i;
+
+    if (_qqbar_composed_cache != NULL)
+    {
+        for (i = 0; i < QQBAR_COMPOSED_CACHE_SIZE; i++)
+        {
+            fmpz_poly_clear(&_qqbar_composed_cache[i].A);
+            fmpz_poly_clear(&_qqbar_composed_cache[i].B);
+            fmpz_poly_factor_clear(&_qqbar_composed_cache[i].fac);
+        }
+
+        flint_free(_qqbar_composed_cache);
+        _qqbar_composed_cache = NULL;
+    }
+}
+
+int
+_qqbar_composed_cache_lookup(fmpz_poly_factor_t fac, const fmpz_poly_t A, const fmpz_poly_t B, int op)
+{
+    qqbar_composed_cache_entry * entry;
+    const fmpz_poly_struct * a = A;
+    const fmpz_poly_struct * b = B;
+    ulong key;
+
+    if (_qqbar_composed_cache == NULL)
+    {
+        _qqbar_stats.composed_cache_misses++;
+        return 0;
+    }
+
+    key = _qqbar_composed_cache_key(&a, &b, op);
+    entry = _qqbar_composed_cache + (key % QQBAR_COMPOSED_CACHE_SIZE);
+
+    if (entry->used && entry->op == op && fmpz_poly_equal(&entry->A, a) && fmpz_poly_equal(&entry->B, b))
+    {
+        fmpz_poly_factor_set(fac, &entry->fac);
+        _qqbar_stats.composed_cache_hits++;
+        return 1;
+    }
+
+    _qqbar_stats.composed_cache_misses++;
+    return 0;
+}
+
+void
+_qqbar_composed_cache_insert(const fmpz_poly_t A, const fmpz_poly_t B, int op, const fmpz_poly_factor_t fac)
+{
+    qqbar_composed_cache_entry * entry;
+    const fmpz_poly_struct * a = A;
+    const fmpz_poly_struct * b = B;
+    ulong key;
+    slong i;
+
+    if (_qqbar_composed_cache == NULL)
+    {
+        _qqbar_composed_cache = flint_malloc(sizeof(qqbar_composed_cache_entry) * QQBAR_COMPOSED_CACHE_SIZE);
+
+        for (i = 0; i < QQBAR_COMPOSED_CACHE_SIZE; i++)
+        {
+            fmpz_poly_init(&_qqbar_composed_cache[i].A);
+            fmpz_poly_init(&_qqbar_composed_cache[i].B);
+            fmpz_poly_factor_init(&_qqbar_composed_cache[i].fac);
+            _qqbar_composed_cache[i].op = 0;
+            _qqbar_composed_cache[i].used = 0;
+        }
+
+        flint_register_cleanup_function(qqbar_composed_cache_clear);
+    }
+
+    key = _qqbar_composed_cache_key(&a, &b, op);
+    entry = _qqbar_composed_cache + (key % QQBAR_COMPOSED_CACHE_SIZE);
+
+    fmpz_poly_set(&entry->A, a);
+    fmpz_poly_set(&entry->B, b);
+    fmpz_poly_factor_set(&entry->fac, fac);
+    entry->op = op;
+    entry->used = 1;
+}
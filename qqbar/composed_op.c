@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <time.h>
 #include "arb_fmpz_poly.h"
 #include "qqbar.h"
 
@@ -105,6 +106,9 @@ fmpq_poly_inv_borel_transform(fmpq_poly_t res, const fmpq_poly_t poly)
     }
 }
 
+/* Below this output degree, the power series over Q are cheap enough. */
+#define MULTIMOD_CUTOFF 64
+
 void
 qqbar_fmpz_poly_composed_op(fmpz_poly_t res, const fmpz_poly_t A, const fmpz_poly_t B, int op)
 {
@@ -120,6 +124,12 @@ qqbar_fmpz_poly_composed_op(fmpz_poly_t res, const fmpz_poly_t A, const fmpz_pol
         flint_abort();
     }
 
+    if (d1 * d2 >= MULTIMOD_CUTOFF)
+    {
+        _qqbar_fmpz_poly_composed_op_multimod(res, A, B, op);
+        return;
+    }
+
     n = d1 * d2 + 1;
 
     fmpq_poly_init(P1);
@@ -228,8 +238,24 @@ qqbar_binary_op_without_guess(qqbar_t res, const qqbar_t x, const qqbar_t y, int
         TIMEIT_ONCE_STOP
     }
 #else
-    qqbar_fmpz_poly_composed_op(H, QQBAR_POLY(x), QQBAR_POLY(y), op);
-    fmpz_poly_factor(fac, H);
+    /* Only the root selection below depends on x and y beyond their
+       minimal polynomials. */
+    if (!_qqbar_composed_cache_lookup(fac, QQBAR_POLY(x), QQBAR_POLY(y), op))
+    {
+        clock_t t0;
+
+        qqbar_fmpz_poly_composed_op(H, QQBAR_POLY(x), QQBAR_POLY(y), op);
+
+        t0 = clock();
+        fmpz_poly_factor(fac, H);
+        _qqbar_stats.factor_time += (double) (clock() - t0) / CLOCKS_PER_SEC;
+
+        _qqbar_stats.composed_ops++;
+        _qqbar_stats.composed_degree += fmpz_poly_degree(H);
+        _qqbar_stats.composed_max_degree = FLINT_MAX(_qqbar_stats.composed_max_degree, fmpz_poly_degree(H));
+
+        _qqbar_composed_cache_insert(QQBAR_POLY(x), QQBAR_POLY(y), op, fac);
+    }
 #endif
 
     acb_set(z1, QQBAR_ENCLOSURE(x));
@@ -0,0 +1,261 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "flint/nmod_poly.h"
+#include "qqbar.h"
+
+#define OP_ADD 0
+#define OP_SUB 1
+#define OP_MUL 2
+#define OP_DIV 3
+
+/* res[i] = poly[i] / i! (inverse = 0) or poly[i] * i! (inverse = 1),
+   given the factorials modulo p */
+static void
+_nmod_poly_borel_transform(nmod_poly_t res, const nmod_poly_t poly, mp_srcptr fac, int inverse)
+{
+    slong i;
+
+    nmod_poly_set(res, poly);
+
+    for (i = 2; i < res->length; i++)
+    {
+        if (inverse)
+            res->coeffs[i] = nmod_mul(res->coeffs[i], fac[i], res->mod);
+        else
+            res->coeffs[i] = nmod_div(res->coeffs[i], fac[i], res->mod);
+    }
+
+    _nmod_poly_normalise(res);
+}
+
+/* Same algorithm as the power series version over Q. This requires that
+   p > d1 d2 and that the constant terms of the reversed inputs
+   are invertible. The output is monic. */
+static void
+_nmod_poly_composed_op(nmod_poly_t res, const nmod_poly_t A, const nmod_poly_t B, int op, mp_srcptr fac)
+{
+    slong d1, d2, n, i;
+    nmod_poly_t P1, P2, P1rev, P1drev, P2rev, P2drev;
+
+    d1 = nmod_poly_degree(A);
+    d2 = nmod_poly_degree(B);
+    n = d1 * d2 + 1;
+
+    nmod_poly_init_mod(P1, A->mod);
+    nmod_poly_init_mod(P2, A->mod);
+    nmod_poly_init_mod(P1rev, A->mod);
+    nmod_poly_init_mod(P1drev, A->mod);
+    nmod_poly_init_mod(P2rev, A->mod);
+    nmod_poly_init_mod(P2drev, A->mod);
+
+    nmod_poly_set(P1, A);
+    nmod_poly_set(P2, B);
+
+    if (op == OP_DIV)
+        nmod_poly_reverse(P2, P2, d2 + 1);
+
+    if (op == OP_SUB)
+        for (i = 1; i <= d2; i += 2)
+            P2->coeffs[i] = nmod_neg(P2->coeffs[i], P2->mod);
+
+    nmod_poly_reverse(P1rev, P1, d1 + 1);
+    nmod_poly_derivative(P1drev, P1);
+    nmod_poly_reverse(P1drev, P1drev, d1);
+
+    nmod_poly_reverse(P2rev, P2, d2 + 1);
+    nmod_poly_derivative(P2drev, P2);
+    nmod_poly_reverse(P2drev, P2drev, d2);
+
+    nmod_poly_div_series(P1, P1drev, P1rev, n);
+    nmod_poly_div_series(P2, P2drev, P2rev, n);
+
+    if (op == OP_MUL || op == OP_DIV)
+    {
+        slong len = FLINT_MIN(P1->length, P2->length);
+
+        for (i = 0; i < len; i++)
+            P1->coeffs[i] = nmod_mul(P1->coeffs[i], P2->coeffs[i], P1->mod);
+        P1->length = len;
+        _nmod_poly_normalise(P1);
+
+        nmod_poly_shift_right(P1, P1, 1);
+        nmod_poly_neg(P1, P1);
+        nmod_poly_integral(P1, P1);
+    }
+    else
+    {
+        _nmod_poly_borel_transform(P1, P1, fac, 0);
+        _nmod_poly_borel_transform(P2, P2, fac, 0);
+        nmod_poly_mullow(P1, P1, P2, n);
+        nmod_poly_shift_right(P1, P1, 1);
+        _nmod_poly_borel_transform(P1, P1, fac, 1);
+        nmod_poly_neg(P1, P1);
+        nmod_poly_shift_left(P1, P1, 1);
+    }
+
+    nmod_poly_exp_series(P1, P1, n);
+    nmod_poly_reverse(res, P1, n);
+
+    nmod_poly_clear(P1);
+    nmod_poly_clear(P2);
+    nmod_poly_clear(P1rev);
+    nmod_poly_clear(P1drev);
+    nmod_poly_clear(P2rev);
+    nmod_poly_clear(P2drev);
+}
+
+/* Upper bound for the absolute values of the roots of the polynomial
+   with coefficients c[0], ..., c[len - 1] where c[lead] is nonzero,
+   reading the coefficients in reverse order if lead = 0. */
+static void
+_fmpz_poly_root_bound(fmpz_t res, const fmpz * c, slong len, slong lead)
+{
+    slong i;
+    fmpz_t t;
+
+    fmpz_init(t);
+    fmpz_zero(res);
+
+    for (i = 0; i < len; i++)
+        if (i != lead && fmpz_cmpabs(c + i, res) > 0)
+            fmpz_abs(res, c + i);
+
+    /* Cauchy: 1 + max |c_i / c_lead| */
+    fmpz_abs(t, c + lead);
+    fmpz_cdiv_q(res, res, t);
+    fmpz_add_ui(res, res, 1);
+
+    fmpz_clear(t);
+}
+
+void
+_qqbar_fmpz_poly_composed_op_multimod(fmpz_poly_t res, const fmpz_poly_t A, const fmpz_poly_t B, int op)
+{
+    slong d1, d2, n, i;
+    flint_bitcnt_t bound_bits;
+    fmpz_t lc, RA, RB, M;
+    const fmpz * b;
+    mp_ptr fac;
+    nmod_poly_t Ap, Bp, Hp;
+    nmod_t mod;
+    mp_limb_t p;
+    int first;
+
+    d1 = fmpz_poly_degree(A);
+    d2 = fmpz_poly_degree(B);
+
+    if (d1 <= 0 || d2 <= 0)
+    {
+        flint_printf("composed_op: inputs must not be constants\n");
+        flint_abort();
+    }
+
+    if (op == OP_DIV && fmpz_is_zero(B->coeffs))
+    {
+        flint_printf("composed_op: division by zero\n");
+        flint_abort();
+    }
+
+    n = d1 * d2;
+
+    fmpz_init(lc);
+    fmpz_init(RA);
+    fmpz_init(RB);
+    fmpz_init(M);
+
+    /* The output is the monic composed polynomial times
+       lc = lc(A)^d2 lc(B')^d1, where B' = B (or B reversed for division),
+       i.e. the resultant, which has integer coefficients. */
+    b = (op == OP_DIV) ? B->coeffs : B->coeffs + d2;
+    fmpz_pow_ui(lc, A->coeffs + d1, d2);
+    fmpz_pow_ui(M, b, d1);
+    fmpz_mul(lc, lc, M);
+
+    /* The roots are bounded by R = RA + RB (sum, difference)
+       or R = RA RB (product, quotient), so the coefficients of the
+       resultant are bounded by |lc| (1 + R)^n. */
+    _fmpz_poly_root_bound(RA, A->coeffs, d1 + 1, d1);
+    _fmpz_poly_root_bound(RB, B->coeffs, d2 + 1, (op == OP_DIV) ? 0 : d2);
+
+    if (op == OP_ADD || op == OP_SUB)
+        fmpz_add(RA, RA, RB);
+    else
+        fmpz_mul(RA, RA, RB);
+
+    fmpz_add_ui(RA, RA, 1);
+    bound_bits = fmpz_bits(lc) + n * fmpz_bits(RA) + 2;
+
+    fac = flint_malloc(sizeof(mp_limb_t) * (n + 1));
+
+    nmod_poly_init(Ap, 2);
+    nmod_poly_init(Bp, 2);
+    nmod_poly_init(Hp, 2);
+
+    fmpz_one(M);
+    first = 1;
+    p = UWORD(1) << (FLINT_BITS - 1);
+
+    while (fmpz_bits(M) <= bound_bits)
+    {
+        p = n_nextprime(p, 1);
+
+        /* the degrees must be preserved and the leading coefficients
+           of the (reversed) inputs must be invertible */
+        if (fmpz_fdiv_ui(A->coeffs + d1, p) == 0 ||
+            fmpz_fdiv_ui(B->coeffs + d2, p) == 0 ||
+            fmpz_fdiv_ui(b, p) == 0)
+            continue;
+
+        nmod_init(&mod, p);
+
+        fac[0] = 1;
+        for (i = 1; i <= n; i++)
+            fac[i] = nmod_mul(fac[i - 1], i, mod);
+
+        nmod_poly_clear(Ap);
+        nmod_poly_clear(Bp);
+        nmod_poly_clear(Hp);
+        nmod_poly_init_mod(Ap, mod);
+        nmod_poly_init_mod(Bp, mod);
+        nmod_poly_init_mod(Hp, mod);
+
+        fmpz_poly_get_nmod_poly(Ap, A);
+        fmpz_poly_get_nmod_poly(Bp, B);
+
+        _nmod_poly_composed_op(Hp, Ap, Bp, op, fac);
+        nmod_poly_scalar_mul_nmod(Hp, Hp, fmpz_fdiv_ui(lc, p));
+
+        if (first)
+        {
+            fmpz_poly_set_nmod_poly(res, Hp);
+            fmpz_set_ui(M, p);
+            first = 0;
+        }
+        else
+        {
+            fmpz_poly_CRT_ui(res, res, M, Hp, 1);
+            fmpz_mul_ui(M, M, p);
+        }
+    }
+
+    fmpz_poly_primitive_part(res, res);
+
+    nmod_poly_clear(Ap);
+    nmod_poly_clear(Bp);
+    nmod_poly_clear(Hp);
+    flint_free(fac);
+
+    fmpz_clear(lc);
+    fmpz_clear(RA);
+    fmpz_clear(RB);
+    fmpz_clear(M);
+}
@@ -0,0 +1,31 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "qqbar.h"
+
+FLINT_TLS_PREFIX qqbar_stats_struct _qqbar_stats = { 0, 0, 0, 0.0, 0, 0 };
+
+void
+qqbar_stats_get(qqbar_stats_t stats)
+{
+    *stats = _qqbar_stats;
+}
+
+void
+qqbar_stats_reset(void)
+{
+    _qqbar_stats.composed_ops = 0;
+    _qqbar_stats.composed_degree = 0;
+    _qqbar_stats.composed_max_degree = 0;
+    _qqbar_stats.factor_time = 0.0;
+    _qqbar_stats.composed_cache_hits = 0;
+    _qqbar_stats.composed_cache_misses = 0;
+}
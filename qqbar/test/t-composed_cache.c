@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "qqbar.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("composed_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * calcium_test_multiplier(); iter++)
+    {
+        qqbar_t x, y, a, b, c;
+        qqbar_stats_t s;
+        int op;
+
+        qqbar_init(x);
+        qqbar_init(y);
+        qqbar_init(a);
+        qqbar_init(b);
+        qqbar_init(c);
+
+        op = n_randint(state, 4);
+
+        /* degrees below 4 avoid the guessing path in qqbar_binary_op */
+        qqbar_randtest(x, state, 3, 10);
+        do {
+            qqbar_randtest(y, state, 3, 10);
+        } while (op == 3 && qqbar_is_zero(y));
+
+        if (n_randint(state, 2))
+            qqbar_composed_cache_clear();
+
+        qqbar_binary_op(a, x, y, op);
+
+        /* conj(x) op conj(y) = conj(x op y) uses the same factorization */
+        qqbar_stats_reset();
+        qqbar_conj(x, x);
+        qqbar_conj(y, y);
+        qqbar_binary_op(b, x, y, op);
+        qqbar_conj(b, b);
+        qqbar_stats_get(s);
+
+        if (!qqbar_equal(a, b) || s->composed_cache_hits != 1 || s->composed_ops != 0)
+        {
+            flint_printf("FAIL (conj)\n");
+            flint_printf("op = %d\n", op);
+            flint_printf("x = "); qqbar_print(x); flint_printf("\n");
+            flint_printf("y = "); qqbar_print(y); flint_printf("\n");
+            flint_printf("a = "); qqbar_print(a); flint_printf("\n");
+            flint_printf("b = "); qqbar_print(b); flint_printf("\n");
+            flint_printf("hits = %wd, ops = %wd\n", s->composed_cache_hits, s->composed_ops);
+            flint_abort();
+        }
+
+        /* the key is symmetric for addition and multiplication */
+        if (op == 0 || op == 2)
+        {
+            qqbar_conj(x, x);
+            qqbar_conj(y, y);
+            qqbar_binary_op(c, y, x, op);
+            qqbar_stats_get(s);
+
+            if (!qqbar_equal(a, c) || s->composed_cache_hits != 2)
+            {
+                flint_printf("FAIL (swap)\n");
+                flint_printf("op = %d\n", op);
+                flint_printf("x = "); qqbar_print(x); flint_printf("\n");
+                flint_printf("y = "); qqbar_print(y); flint_printf("\n");
+                flint_printf("a = "); qqbar_print(a); flint_printf("\n");
+                flint_printf("c = "); qqbar_print(c); flint_printf("\n");
+                flint_abort();
+            }
+        }
+
+        qqbar_clear(x);
+        qqbar_clear(y);
+        qqbar_clear(a);
+        qqbar_clear(b);
+        qqbar_clear(c);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
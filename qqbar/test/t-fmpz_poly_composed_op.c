@@ -119,6 +119,50 @@ int main()
         fmpq_clear(y);
     }
 
+    /* Compare the multimodular algorithm with the power series over Q. */
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        fmpz_poly_t A, B, C, D;
+        int op;
+
+        fmpz_poly_init(A);
+        fmpz_poly_init(B);
+        fmpz_poly_init(C);
+        fmpz_poly_init(D);
+
+        op = n_randint(state, 4);
+
+        /* degrees at most 7, below the multimodular cutoff */
+        do {
+            fmpz_poly_randtest(A, state, 2 + n_randint(state, 7), 1 + n_randint(state, 40));
+        } while (fmpz_poly_degree(A) < 1);
+
+        do {
+            fmpz_poly_randtest(B, state, 2 + n_randint(state, 7), 1 + n_randint(state, 40));
+        } while (fmpz_poly_degree(B) < 1 || (op == 3 && fmpz_is_zero(B->coeffs)));
+
+        fmpz_poly_randtest(D, state, 10, 100);
+
+        qqbar_fmpz_poly_composed_op(C, A, B, op);
+        _qqbar_fmpz_poly_composed_op_multimod(D, A, B, op);
+
+        if (!fmpz_poly_equal(C, D))
+        {
+            flint_printf("FAIL (multimod)\n");
+            flint_printf("op = %d\n", op);
+            flint_printf("A = "); fmpz_poly_print(A); flint_printf("\n\n");
+            flint_printf("B = "); fmpz_poly_print(B); flint_printf("\n\n");
+            flint_printf("C = "); fmpz_poly_print(C); flint_printf("\n\n");
+            flint_printf("D = "); fmpz_poly_print(D); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        fmpz_poly_clear(A);
+        fmpz_poly_clear(B);
+        fmpz_poly_clear(C);
+        fmpz_poly_clear(D);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
@@ -33,6 +33,7 @@ void fmpz_mpoly_symmetric_gens(fmpz_mpoly_t res, ulong k, slong * vars, slong n,
 void fmpz_mpoly_symmetric(fmpz_mpoly_t res, ulong k, const fmpz_mpoly_ctx_t ctx);
 void fmpz_mpoly_primitive_part(fmpz_mpoly_t res, const fmpz_mpoly_t f, const fmpz_mpoly_ctx_t ctx);
 void fmpz_mpoly_spoly(fmpz_mpoly_t res, const fmpz_mpoly_t f, const fmpz_mpoly_t g, const fmpz_mpoly_ctx_t ctx);
+slong fmpz_mpoly_allocated_bytes(const fmpz_mpoly_t x, const fmpz_mpoly_ctx_t ctx);
 
 /* Vectors of multivariate polynomials */
 
@@ -162,6 +163,8 @@ fmpz_mpoly_vec_insert_unique(fmpz_mpoly_vec_t vec, const fmpz_mpoly_t f, const f
 
 void fmpz_mpoly_vec_set_length(fmpz_mpoly_vec_t vec, slong len, const fmpz_mpoly_ctx_t ctx);
 
+slong fmpz_mpoly_vec_allocated_bytes(const fmpz_mpoly_vec_t vec, const fmpz_mpoly_ctx_t ctx);
+
 UTILS_FLINT_INLINE void
 fmpz_mpoly_vec_randtest_not_zero(fmpz_mpoly_vec_t vec, flint_rand_t state, slong len, slong poly_len, slong bits, ulong exp_bound, fmpz_mpoly_ctx_t ctx)
 {
@@ -258,12 +261,28 @@ pair_t fmpz_mpoly_select_pop_pair(pairs_t pairs, const fmpz_mpoly_vec_t G, const
 void fmpz_mpoly_buchberger_naive(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F, const fmpz_mpoly_ctx_t ctx);
 int fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
     slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx);
+int _fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx);
+
+void fmpz_mpoly_buchberger(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F, const fmpz_mpoly_ctx_t ctx);
+int fmpz_mpoly_buchberger_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx);
+int _fmpz_mpoly_buchberger_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx);
+int _fmpz_mpoly_buchberger_extend_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong known_len, slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx);
 
 void fmpz_mpoly_vec_autoreduction(fmpz_mpoly_vec_t H, const fmpz_mpoly_vec_t F, const fmpz_mpoly_ctx_t ctx);
 void fmpz_mpoly_vec_autoreduction_groebner(fmpz_mpoly_vec_t H, const fmpz_mpoly_vec_t G, const fmpz_mpoly_ctx_t ctx);
 
 int fmpz_mpoly_vec_is_autoreduced(const fmpz_mpoly_vec_t G, const fmpz_mpoly_ctx_t ctx);
 
+int fmpz_mpoly_vec_fglm(fmpz_mpoly_vec_t H, const fmpz_mpoly_ctx_t hctx,
+    const fmpz_mpoly_vec_t G, const fmpz_mpoly_ctx_t gctx, slong dim_limit);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils_flint.h"
+
+slong
+fmpz_mpoly_allocated_bytes(const fmpz_mpoly_t x, const fmpz_mpoly_ctx_t ctx)
+{
+    slong i, N, size;
+
+    N = mpoly_words_per_exp(x->bits, ctx->minfo);
+
+    size = x->length * (sizeof(fmpz) + N * sizeof(ulong));
+
+    for (i = 0; i < x->length; i++)
+        if (COEFF_IS_MPZ(x->coeffs[i]))
+            size += sizeof(__mpz_struct) + COEFF_TO_PTR(x->coeffs[i])->_mp_alloc * sizeof(mp_limb_t);
+
+    return size;
+}
+
+slong
+fmpz_mpoly_vec_allocated_bytes(const fmpz_mpoly_vec_t vec, const fmpz_mpoly_ctx_t ctx)
+{
+    slong i, size;
+
+    size = vec->alloc * sizeof(fmpz_mpoly_struct);
+
+    for (i = 0; i < vec->length; i++)
+        size += fmpz_mpoly_allocated_bytes(vec->p + i, ctx);
+
+    return size;
+}
@@ -0,0 +1,280 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils_flint.h"
+
+static int
+within_limits(const fmpz_mpoly_t poly, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx)
+{
+    slong bits;
+
+    if (fmpz_mpoly_length(poly, ctx) > poly_len_limit)
+        return 0;
+
+    bits = fmpz_mpoly_max_bits(poly);
+    bits = FLINT_ABS(bits);
+
+    if (bits > poly_bits_limit)
+        return 0;
+
+    return 1;
+}
+
+/* Operations on exponent vectors of leading monomials */
+
+static int
+_exp_divides(const ulong * a, const ulong * b, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < nvars; i++)
+        if (a[i] > b[i])
+            return 0;
+
+    return 1;
+}
+
+static int
+_exp_equal(const ulong * a, const ulong * b, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < nvars; i++)
+        if (a[i] != b[i])
+            return 0;
+
+    return 1;
+}
+
+static int
+_exp_coprime(const ulong * a, const ulong * b, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < nvars; i++)
+        if (a[i] != 0 && b[i] != 0)
+            return 0;
+
+    return 1;
+}
+
+static void
+_exp_lcm(ulong * res, const ulong * a, const ulong * b, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < nvars; i++)
+        res[i] = FLINT_MAX(a[i], b[i]);
+}
+
+/* Gebauer-Moeller update of the critical pairs B after appending the
+   polynomial with index t, whose leading exponent is lm + t * nvars.
+   Polynomials that are no longer active (because their leading monomial
+   is divisible by that of a later polynomial) are kept for reduction
+   but do not form new pairs. */
+static void
+_fmpz_mpoly_buchberger_update(pairs_t B, int * active, const ulong * lm, slong t, slong nvars)
+{
+    ulong * lcm;
+    ulong * tmp;
+    const ulong * lmt;
+    int * keep;
+    slong i, j, k, len;
+    int coprime;
+
+    lcm = flint_malloc(sizeof(ulong) * (t + 1) * nvars);
+    tmp = lcm + t * nvars;
+    keep = flint_malloc(sizeof(int) * (t + 1));
+    lmt = lm + t * nvars;
+
+    for (i = 0; i < t; i++)
+    {
+        _exp_lcm(lcm + i * nvars, lm + i * nvars, lmt, nvars);
+        keep[i] = active[i];
+    }
+
+    /* Criterion B: drop an old pair (i, j) if lm(t) divides lcm(i, j)
+       and lcm(i, j) differs from both lcm(i, t) and lcm(j, t). */
+    for (k = len = 0; k < B->length; k++)
+    {
+        i = B->pairs[k].a;
+        j = B->pairs[k].b;
+
+        _exp_lcm(tmp, lm + i * nvars, lm + j * nvars, nvars);
+
+        if (_exp_divides(lmt, tmp, nvars) &&
+            !_exp_equal(tmp, lcm + i * nvars, nvars) &&
+            !_exp_equal(tmp, lcm + j * nvars, nvars))
+            continue;
+
+        B->pairs[len] = B->pairs[k];
+        len++;
+    }
+
+    B->length = len;
+
+    /* Criterion M: drop (i, t) if some lcm(j, t) properly divides lcm(i, t). */
+    for (i = 0; i < t; i++)
+    {
+        if (!keep[i])
+            continue;
+
+        for (j = 0; j < t; j++)
+        {
+            if (j != i && active[j] &&
+                _exp_divides(lcm + j * nvars, lcm + i * nvars, nvars) &&
+                !_exp_equal(lcm + j * nvars, lcm + i * nvars, nvars))
+            {
+                keep[i] = 0;
+                break;
+            }
+        }
+    }
+
+    /* Criterion F: keep one pair per lcm; the product criterion then
+       removes the whole class if any member has coprime leading monomials. */
+    for (i = 0; i < t; i++)
+    {
+        if (!keep[i])
+            continue;
+
+        coprime = _exp_coprime(lm + i * nvars, lmt, nvars);
+
+        for (j = i + 1; j < t; j++)
+        {
+            if (keep[j] && _exp_equal(lcm + i * nvars, lcm + j * nvars, nvars))
+            {
+                coprime = coprime || _exp_coprime(lm + j * nvars, lmt, nvars);
+                keep[j] = 0;
+            }
+        }
+
+        if (!coprime)
+            pairs_append(B, i, t);
+    }
+
+    for (i = 0; i < t; i++)
+        if (active[i] && _exp_divides(lmt, lm + i * nvars, nvars))
+            active[i] = 0;
+
+    active[t] = 1;
+
+    flint_free(lcm);
+    flint_free(keep);
+}
+
+int
+_fmpz_mpoly_buchberger_extend_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong known_len, slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx)
+{
+    pairs_t B;
+    fmpz_mpoly_t h;
+    slong i, nvars, alloc;
+    ulong * lm;
+    int * active;
+    pair_t pair;
+    int success;
+
+    fmpz_mpoly_vec_set_primitive_unique(G, F, ctx);
+
+    if (G->length <= 1)
+        return 1;
+
+    if (G->length >= ideal_len_limit)
+        return 0;
+
+    for (i = 0; i < G->length; i++)
+        if (!within_limits(fmpz_mpoly_vec_entry(G, i), poly_len_limit, poly_bits_limit, ctx))
+            return 0;
+
+    nvars = ctx->minfo->nvars;
+    alloc = 2 * G->length;
+    lm = flint_malloc(sizeof(ulong) * alloc * nvars);
+    active = flint_malloc(sizeof(int) * alloc);
+
+    pairs_init(B);
+    fmpz_mpoly_init(h, ctx);
+
+    for (i = 0; i < G->length; i++)
+    {
+        fmpz_mpoly_get_term_exp_ui(lm + i * nvars, fmpz_mpoly_vec_entry(G, i), 0, ctx);
+        _fmpz_mpoly_buchberger_update(B, active, lm, i, nvars);
+
+        /* the S-polynomials of a known Groebner basis reduce to zero */
+        if (i == known_len - 1)
+            B->length = 0;
+    }
+
+    success = 1;
+    while (B->length != 0)
+    {
+        pair = fmpz_mpoly_select_pop_pair(B, G, ctx);
+
+        fmpz_mpoly_spoly(h, fmpz_mpoly_vec_entry(G, pair.a), fmpz_mpoly_vec_entry(G, pair.b), ctx);
+        fmpz_mpoly_reduction_primitive_part(h, h, G, ctx);
+
+        if (callback != NULL && callback(callback_data))
+        {
+            success = 0;
+            break;
+        }
+
+        if (!fmpz_mpoly_is_zero(h, ctx))
+        {
+            if (G->length >= ideal_len_limit || !within_limits(h, poly_len_limit, poly_bits_limit, ctx))
+            {
+                success = 0;
+                break;
+            }
+
+            if (G->length == alloc)
+            {
+                alloc *= 2;
+                lm = flint_realloc(lm, sizeof(ulong) * alloc * nvars);
+                active = flint_realloc(active, sizeof(int) * alloc);
+            }
+
+            i = G->length;
+            fmpz_mpoly_vec_append(G, h, ctx);
+            fmpz_mpoly_get_term_exp_ui(lm + i * nvars, h, 0, ctx);
+            _fmpz_mpoly_buchberger_update(B, active, lm, i, nvars);
+        }
+    }
+
+    fmpz_mpoly_clear(h, ctx);
+    pairs_clear(B);
+    flint_free(lm);
+    flint_free(active);
+
+    return success;
+}
+
+int
+_fmpz_mpoly_buchberger_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx)
+{
+    return _fmpz_mpoly_buchberger_extend_with_limits(G, F, 0, ideal_len_limit, poly_len_limit, poly_bits_limit, callback, callback_data, ctx);
+}
+
+int
+fmpz_mpoly_buchberger_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx)
+{
+    return _fmpz_mpoly_buchberger_with_limits(G, F, ideal_len_limit, poly_len_limit, poly_bits_limit, NULL, NULL, ctx);
+}
+
+void
+fmpz_mpoly_buchberger(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F, const fmpz_mpoly_ctx_t ctx)
+{
+    fmpz_mpoly_buchberger_with_limits(G, F, WORD_MAX, WORD_MAX, WORD_MAX, ctx);
+}
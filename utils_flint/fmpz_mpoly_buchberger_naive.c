@@ -53,8 +53,9 @@ fmpz_mpoly_disjoint_lt(const fmpz_mpoly_t f, const fmpz_mpoly_t g, const fmpz_mp
 }
 
 int
-fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
-    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx)
+_fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit,
+    int (*callback)(void *), void * callback_data, const fmpz_mpoly_ctx_t ctx)
 {
     pairs_t B;
     fmpz_mpoly_t h;
@@ -90,6 +91,12 @@ fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec
         fmpz_mpoly_spoly(h, fmpz_mpoly_vec_entry(G, pair.a), fmpz_mpoly_vec_entry(G, pair.b), ctx);
         fmpz_mpoly_reduction_primitive_part(h, h, G, ctx);
 
+        if (callback != NULL && callback(callback_data))
+        {
+            success = 0;
+            break;
+        }
+
         if (!fmpz_mpoly_is_zero(h, ctx))
         {
             /* printf("h stats %ld, %ld, %ld\n", h->length, h->bits, G->length); */
@@ -115,6 +122,13 @@ fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec
     return success;
 }
 
+int
+fmpz_mpoly_buchberger_naive_with_limits(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F,
+    slong ideal_len_limit, slong poly_len_limit, slong poly_bits_limit, const fmpz_mpoly_ctx_t ctx)
+{
+    return _fmpz_mpoly_buchberger_naive_with_limits(G, F, ideal_len_limit, poly_len_limit, poly_bits_limit, NULL, NULL, ctx);
+}
+
 void
 fmpz_mpoly_buchberger_naive(fmpz_mpoly_vec_t G, const fmpz_mpoly_vec_t F, const fmpz_mpoly_ctx_t ctx)
 {
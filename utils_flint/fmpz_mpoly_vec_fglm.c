@@ -0,0 +1,394 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "flint/fmpq_vec.h"
+#include "flint/fmpq_mat.h"
+#include "utils_flint.h"
+
+/* Compares exponent vectors in the given monomial ordering. */
+static int
+_exp_cmp(const ulong * a, const ulong * b, slong nvars, ordering_t ord)
+{
+    slong i;
+    ulong da, db;
+
+    if (ord != ORD_LEX)
+    {
+        da = db = 0;
+        for (i = 0; i < nvars; i++)
+        {
+            da += a[i];
+            db += b[i];
+        }
+
+        if (da != db)
+            return (da < db) ? -1 : 1;
+    }
+
+    if (ord == ORD_DEGREVLEX)
+    {
+        for (i = nvars - 1; i >= 0; i--)
+            if (a[i] != b[i])
+                return (a[i] > b[i]) ? -1 : 1;
+    }
+    else
+    {
+        for (i = 0; i < nvars; i++)
+            if (a[i] != b[i])
+                return (a[i] < b[i]) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static int
+_exp_divides(const ulong * a, const ulong * b, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < nvars; i++)
+        if (a[i] > b[i])
+            return 0;
+
+    return 1;
+}
+
+/* Index of exp in the array of len exponent vectors, or -1. */
+static slong
+_exp_find(const ulong * exps, slong len, const ulong * exp, slong nvars)
+{
+    slong i, j;
+
+    for (i = 0; i < len; i++)
+    {
+        for (j = 0; j < nvars; j++)
+            if (exps[i * nvars + j] != exp[j])
+                break;
+
+        if (j == nvars)
+            return i;
+    }
+
+    return -1;
+}
+
+/* Whether exp is divisible by one of the len leading exponents. */
+static int
+_exp_reducible(const ulong * lm, slong len, const ulong * exp, slong nvars)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (_exp_divides(lm + i * nvars, exp, nvars))
+            return 1;
+
+    return 0;
+}
+
+int
+fmpz_mpoly_vec_fglm(fmpz_mpoly_vec_t H, const fmpz_mpoly_ctx_t hctx,
+    const fmpz_mpoly_vec_t G, const fmpz_mpoly_ctx_t gctx, slong dim_limit)
+{
+    slong nvars, glen, dim, alloc, i, j, k, r, num_cand, max_cand, hlen, pivot;
+    ulong * glm;        /* leading exponents of G */
+    ulong * stair;      /* standard monomials of G */
+    ulong * basis;      /* standard monomials in the new ordering */
+    ulong * cand;       /* candidate monomials */
+    ulong * hlm;        /* leading exponents of H */
+    ulong * m;
+    slong * piv;
+    fmpq_mat_t M, T;
+    fmpq * w;
+    fmpq * t;
+    fmpq_t f;
+    fmpz_t scale, c, den;
+    fmpz_mpoly_struct ** Q;
+    fmpz_mpoly_struct ** B;
+    fmpz_mpoly_t p, rem;
+    fmpz_mpoly_vec_t res;
+    int success;
+
+    nvars = gctx->minfo->nvars;
+    glen = G->length;
+
+    if (hctx->minfo->nvars != nvars)
+    {
+        flint_printf("fmpz_mpoly_vec_fglm: contexts must have the same number of variables\n");
+        flint_abort();
+    }
+
+    glm = flint_malloc(sizeof(ulong) * (glen + 1) * nvars);
+    m = glm + glen * nvars;
+
+    for (i = 0; i < glen; i++)
+        fmpz_mpoly_get_term_exp_ui(glm + i * nvars, fmpz_mpoly_vec_entry(G, i), 0, gctx);
+
+    /* The ideal is zero-dimensional iff every variable has a pure power
+       among the leading monomials. */
+    for (j = 0; j < nvars; j++)
+    {
+        for (i = 0; i < glen; i++)
+        {
+            for (k = 0; k < nvars; k++)
+                if (k != j && glm[i * nvars + k] != 0)
+                    break;
+
+            if (k == nvars)
+                break;
+        }
+
+        if (i == glen)
+        {
+            flint_free(glm);
+            return 0;
+        }
+    }
+
+    /* Enumerate the standard monomials of G. One extra entry
+       is kept as scratch space. */
+    alloc = 16;
+    stair = flint_malloc(sizeof(ulong) * alloc * nvars);
+
+    dim = 0;
+    for (k = 0; k < nvars; k++)
+        m[k] = 0;
+
+    if (!_exp_reducible(glm, glen, m, nvars))
+    {
+        for (k = 0; k < nvars; k++)
+            stair[k] = 0;
+        dim = 1;
+    }
+
+    success = 1;
+    for (i = 0; i < dim && success; i++)
+    {
+        for (j = 0; j < nvars; j++)
+        {
+            for (k = 0; k < nvars; k++)
+                m[k] = stair[i * nvars + k];
+            m[j]++;
+
+            if (!_exp_reducible(glm, glen, m, nvars) && _exp_find(stair, dim, m, nvars) == -1)
+            {
+                if (dim >= dim_limit)
+                {
+                    success = 0;
+                    break;
+                }
+
+                if (dim + 1 >= alloc)
+                {
+                    alloc *= 2;
+                    stair = flint_realloc(stair, sizeof(ulong) * alloc * nvars);
+                }
+
+                for (k = 0; k < nvars; k++)
+                    stair[dim * nvars + k] = m[k];
+                dim++;
+            }
+        }
+    }
+
+    if (!success)
+    {
+        flint_free(glm);
+        flint_free(stair);
+        return 0;
+    }
+
+    /* Linear algebra: the rows of M are the normal forms of the basis
+       monomials in echelon form (normalised pivots), and M = T V where
+       the rows of V are the normal forms of the basis monomials. */
+    fmpq_mat_init(M, dim + 1, dim);
+    fmpq_mat_init(T, dim + 1, dim + 1);
+    w = _fmpq_vec_init(dim);
+    t = _fmpq_vec_init(dim + 1);
+    piv = flint_malloc(sizeof(slong) * (dim + 1));
+    basis = flint_malloc(sizeof(ulong) * (dim + 1) * nvars);
+    /* every basis monomial adds at most nvars candidates */
+    max_cand = dim * nvars + 1;
+    cand = flint_malloc(sizeof(ulong) * max_cand * nvars);
+    hlm = flint_malloc(sizeof(ulong) * max_cand * nvars);
+    fmpq_init(f);
+    fmpz_init(scale);
+    fmpz_init(c);
+    fmpz_init(den);
+    fmpz_mpoly_init(p, gctx);
+    fmpz_mpoly_init(rem, gctx);
+    fmpz_mpoly_vec_init(res, 0, hctx);
+
+    Q = flint_malloc(sizeof(fmpz_mpoly_struct *) * glen);
+    B = flint_malloc(sizeof(fmpz_mpoly_struct *) * glen);
+    for (i = 0; i < glen; i++)
+    {
+        Q[i] = flint_malloc(sizeof(fmpz_mpoly_struct));
+        fmpz_mpoly_init(Q[i], gctx);
+        B[i] = fmpz_mpoly_vec_entry(G, i);
+    }
+
+    r = 0;
+    hlen = 0;
+
+    for (k = 0; k < nvars; k++)
+        cand[k] = 0;
+    num_cand = 1;
+
+    while (num_cand != 0)
+    {
+        /* Pop the smallest candidate in the new ordering. */
+        j = 0;
+        for (i = 1; i < num_cand; i++)
+            if (_exp_cmp(cand + i * nvars, cand + j * nvars, nvars, hctx->minfo->ord) < 0)
+                j = i;
+
+        for (k = 0; k < nvars; k++)
+            m[k] = cand[j * nvars + k];
+
+        num_cand--;
+        for (k = 0; k < nvars; k++)
+            cand[j * nvars + k] = cand[num_cand * nvars + k];
+
+        if (_exp_reducible(hlm, hlen, m, nvars))
+            continue;
+
+        /* Normal form of m, as a vector w of coordinates with respect
+           to the standard monomials of G. */
+        fmpz_mpoly_zero(p, gctx);
+        fmpz_mpoly_set_coeff_si_ui(p, 1, m, gctx);
+        fmpz_mpoly_quasidivrem_ideal(scale, Q, rem, p, B, glen, gctx);
+
+        for (k = 0; k < dim; k++)
+            fmpq_zero(w + k);
+        for (i = 0; i < fmpz_mpoly_length(rem, gctx); i++)
+        {
+            fmpz_mpoly_get_term_exp_ui(stair + dim * nvars, rem, i, gctx);
+            k = _exp_find(stair, dim, stair + dim * nvars, nvars);
+
+            if (k == -1)
+            {
+                flint_printf("fmpz_mpoly_vec_fglm: G is not a Groebner basis\n");
+                flint_abort();
+            }
+
+            fmpz_mpoly_get_term_coeff_fmpz(c, rem, i, gctx);
+            fmpq_set_fmpz_frac(w + k, c, scale);
+        }
+
+        /* Reduce w by the echelon rows, tracking t with w = t V. */
+        for (k = 0; k < r; k++)
+            fmpq_zero(t + k);
+        fmpq_one(t + r);
+
+        for (i = 0; i < r; i++)
+        {
+            if (!fmpq_is_zero(w + piv[i]))
+            {
+                fmpq_set(f, w + piv[i]);
+
+                for (k = 0; k < dim; k++)
+                    fmpq_submul(w + k, f, fmpq_mat_entry(M, i, k));
+                for (k = 0; k <= i; k++)
+                    fmpq_submul(t + k, f, fmpq_mat_entry(T, i, k));
+            }
+        }
+
+        for (pivot = 0; pivot < dim; pivot++)
+            if (!fmpq_is_zero(w + pivot))
+                break;
+
+        if (pivot == dim)
+        {
+            /* t V = 0 gives the polynomial sum t_k basis_k + m, whose
+               leading monomial is m. */
+            fmpz_one(den);
+            for (k = 0; k <= r; k++)
+                fmpz_lcm(den, den, fmpq_denref(t + k));
+
+            fmpz_mpoly_vec_set_length(res, hlen + 1, hctx);
+            fmpz_mpoly_zero(fmpz_mpoly_vec_entry(res, hlen), hctx);
+
+            for (k = 0; k <= r; k++)
+            {
+                if (!fmpq_is_zero(t + k))
+                {
+                    fmpz_divexact(c, den, fmpq_denref(t + k));
+                    fmpz_mul(c, c, fmpq_numref(t + k));
+                    fmpz_mpoly_set_coeff_fmpz_ui(fmpz_mpoly_vec_entry(res, hlen), c,
+                        (k == r) ? m : basis + k * nvars, hctx);
+                }
+            }
+
+            fmpz_mpoly_primitive_part(fmpz_mpoly_vec_entry(res, hlen), fmpz_mpoly_vec_entry(res, hlen), hctx);
+
+            for (k = 0; k < nvars; k++)
+                hlm[hlen * nvars + k] = m[k];
+            hlen++;
+        }
+        else
+        {
+            /* New standard monomial; r < dim since the normal forms
+               of the basis monomials are linearly independent. */
+            fmpq_inv(f, w + pivot);
+            for (k = 0; k < dim; k++)
+                fmpq_mul(fmpq_mat_entry(M, r, k), w + k, f);
+            for (k = 0; k <= r; k++)
+                fmpq_mul(fmpq_mat_entry(T, r, k), t + k, f);
+
+            piv[r] = pivot;
+            for (k = 0; k < nvars; k++)
+                basis[r * nvars + k] = m[k];
+            r++;
+
+            for (j = 0; j < nvars; j++)
+            {
+                m[j]++;
+                if (_exp_find(cand, num_cand, m, nvars) == -1)
+                {
+                    for (k = 0; k < nvars; k++)
+                        cand[num_cand * nvars + k] = m[k];
+                    num_cand++;
+                }
+                m[j]--;
+            }
+        }
+    }
+
+    fmpz_mpoly_vec_swap(H, res, hctx);
+
+    for (i = 0; i < glen; i++)
+    {
+        fmpz_mpoly_clear(Q[i], gctx);
+        flint_free(Q[i]);
+    }
+
+    flint_free(Q);
+    flint_free(B);
+    fmpq_mat_clear(M);
+    fmpq_mat_clear(T);
+    _fmpq_vec_clear(w, dim);
+    _fmpq_vec_clear(t, dim + 1);
+    flint_free(piv);
+    flint_free(basis);
+    flint_free(cand);
+    flint_free(hlm);
+    flint_free(glm);
+    flint_free(stair);
+    fmpq_clear(f);
+    fmpz_clear(scale);
+    fmpz_clear(c);
+    fmpz_clear(den);
+    fmpz_mpoly_clear(p, gctx);
+    fmpz_mpoly_clear(rem, gctx);
+    fmpz_mpoly_vec_clear(res, hctx);
+
+    return 1;
+}
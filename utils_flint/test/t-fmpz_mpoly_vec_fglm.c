@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2021 Fredrik Johansson
+
+    This file is part of Calcium.
+
+    Calcium is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils_flint.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("fmpz_mpoly_vec_fglm...");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * calcium_test_multiplier(); iter++)
+    {
+        fmpz_mpoly_ctx_t ctx, lex;
+        fmpz_mpoly_vec_t F, G, F2, H, H2;
+        fmpz_mpoly_t p;
+        fmpz_poly_t pol;
+        slong nvars, i, n;
+        slong gen_map[3];
+
+        nvars = 1 + n_randint(state, 3);
+        fmpz_mpoly_ctx_init(ctx, nvars, (n_randint(state, 2) ? ORD_DEGREVLEX : ORD_DEGLEX));
+        fmpz_mpoly_ctx_init(lex, nvars, ORD_LEX);
+
+        fmpz_mpoly_vec_init(F, 0, ctx);
+        fmpz_mpoly_vec_init(G, 0, ctx);
+        fmpz_mpoly_vec_init(F2, 0, lex);
+        fmpz_mpoly_vec_init(H, 0, lex);
+        fmpz_mpoly_vec_init(H2, 0, lex);
+        fmpz_mpoly_init(p, ctx);
+        fmpz_poly_init(pol);
+
+        /* a univariate polynomial in each variable makes the
+           ideal zero-dimensional */
+        for (i = 0; i < nvars; i++)
+        {
+            do {
+                fmpz_poly_randtest_not_zero(pol, state, 2 + n_randint(state, 3), 1 + n_randint(state, 5));
+            } while (fmpz_poly_degree(pol) < 1);
+
+            fmpz_mpoly_set_gen_fmpz_poly(p, i, pol, ctx);
+            fmpz_mpoly_vec_append(F, p, ctx);
+            gen_map[i] = i;
+        }
+
+        for (n = n_randint(state, 3); n > 0; n--)
+        {
+            fmpz_mpoly_randtest_bound(p, state, 1 + n_randint(state, 3), 1 + n_randint(state, 5), 1 + n_randint(state, 3), ctx);
+            if (!fmpz_mpoly_is_zero(p, ctx))
+                fmpz_mpoly_vec_append(F, p, ctx);
+        }
+
+        fmpz_mpoly_vec_set_length(F2, F->length, lex);
+        for (i = 0; i < F->length; i++)
+            fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_vec_entry(F2, i), fmpz_mpoly_vec_entry(F, i), gen_map, ctx, lex);
+
+        fmpz_mpoly_buchberger(G, F, ctx);
+        fmpz_mpoly_vec_autoreduction_groebner(G, G, ctx);
+
+        if (!fmpz_mpoly_vec_fglm(H, lex, G, ctx, WORD_MAX))
+        {
+            flint_printf("FAIL (zero-dimensional)\n\n");
+            flint_printf("F = "); fmpz_mpoly_vec_print(F, ctx); flint_printf("\n");
+            flint_printf("G = "); fmpz_mpoly_vec_print(G, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        fmpz_mpoly_buchberger(H2, F2, lex);
+        fmpz_mpoly_vec_autoreduction_groebner(H2, H2, lex);
+
+        if (!fmpz_mpoly_vec_is_groebner(H, F2, lex) || !fmpz_mpoly_vec_is_autoreduced(H, lex) || H->length != H2->length)
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("F = "); fmpz_mpoly_vec_print(F, ctx); flint_printf("\n");
+            flint_printf("G = "); fmpz_mpoly_vec_print(G, ctx); flint_printf("\n");
+            flint_printf("H = "); fmpz_mpoly_vec_print(H, lex); flint_printf("\n");
+            flint_printf("H2 = "); fmpz_mpoly_vec_print(H2, lex); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* the dimension limit is respected */
+        if (G->length != 0 && fmpz_mpoly_vec_fglm(H, lex, G, ctx, 0) && !fmpz_mpoly_is_one(fmpz_mpoly_vec_entry(G, 0), ctx))
+        {
+            flint_printf("FAIL (dim_limit)\n\n");
+            flint_printf("G = "); fmpz_mpoly_vec_print(G, ctx); flint_printf("\n");
+            flint_abort();
+        }
+
+        fmpz_mpoly_vec_clear(F, ctx);
+        fmpz_mpoly_vec_clear(G, ctx);
+        fmpz_mpoly_vec_clear(F2, lex);
+        fmpz_mpoly_vec_clear(H, lex);
+        fmpz_mpoly_vec_clear(H2, lex);
+        fmpz_mpoly_clear(p, ctx);
+        fmpz_poly_clear(pol);
+
+        fmpz_mpoly_ctx_clear(ctx);
+        fmpz_mpoly_ctx_clear(lex);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}